@@ -371,6 +371,33 @@ bool Adafruit_BME280::takeForcedMeasurement(void) {
   return return_value;
 }
 
+/*!
+ *   @brief  Start a measurement in forced mode without waiting on it. The
+ *           values can be read after measurementTime().
+ *   @returns true if in forced mode and the measurement was started
+ */
+bool Adafruit_BME280::startForcedMeasurement(void) {
+  if (_measReg.mode != MODE_FORCED) {
+    return false;
+  }
+  write8(BME280_REGISTER_CONTROL, _measReg.get());
+  return true;
+}
+
+/*!
+ *   @brief  Maximum time one measurement takes with the current oversampling,
+ *           from the datasheet, appendix B
+ *   @returns microseconds
+ */
+uint32_t Adafruit_BME280::measurementTime(void) {
+  uint32_t t = (_measReg.osrs_t) ? (1 << (_measReg.osrs_t - 1)) : 0;
+  uint32_t p = (_measReg.osrs_p) ? (1 << (_measReg.osrs_p - 1)) : 0;
+  uint32_t h = (_humReg.osrs_h) ? (1 << (_humReg.osrs_h - 1)) : 0;
+
+  return 1250 + (2300 * t) + ((p) ? (2300 * p) + 575 : 0) +
+         ((h) ? (2300 * h) + 575 : 0);
+}
+
 /*!
  *   @brief  Reads the factory-set coefficients
  */
@@ -442,10 +469,19 @@ float Adafruit_BME280::readTemperature(void) {
  *   @returns the pressure value (in Pascal) read from the device
  */
 float Adafruit_BME280::readPressure(void) {
-  int64_t var1, var2, p;
-
   readTemperature(); // must be done first to get t_fine
 
+  return compensatePressure();
+}
+
+/*!
+ *   @brief  Reads the pressure and compensates it with the t_fine from the
+ *           last readTemperature()
+ *   @returns the pressure value (in Pascal) read from the device
+ */
+float Adafruit_BME280::compensatePressure(void) {
+  int64_t var1, var2, p;
+
   int32_t adc_P = read24(BME280_REGISTER_PRESSUREDATA);
   if (adc_P == 0x800000) // value in case pressure measurement was disabled
     return NAN;
@@ -479,6 +515,15 @@ float Adafruit_BME280::readPressure(void) {
 float Adafruit_BME280::readHumidity(void) {
   readTemperature(); // must be done first to get t_fine
 
+  return compensateHumidity();
+}
+
+/*!
+ *  @brief  Reads the humidity and compensates it with the t_fine from the
+ *          last readTemperature()
+ *  @returns the humidity value read from the device
+ */
+float Adafruit_BME280::compensateHumidity(void) {
   int32_t adc_H = read16(BME280_REGISTER_HUMIDDATA);
   if (adc_H == 0x8000) // value in case humidity measurement was disabled
     return NAN;
@@ -510,6 +555,23 @@ float Adafruit_BME280::readHumidity(void) {
   return h / 1024.0;
 }
 
+/*!
+ *  @brief  Reads temperature, pressure and humidity from the same
+ *          measurement, reading the temperature once for t_fine
+ *  @param  snap  Where to store the values
+ *  @returns true if all values are valid
+ */
+bool Adafruit_BME280::snapshot(bme280_snapshot_t *snap) {
+  snap->temperature = readTemperature();
+  if (isnan(snap->temperature)) {
+    snap->pressure = snap->humidity = NAN;
+    return false;
+  }
+  snap->pressure = compensatePressure();
+  snap->humidity = compensateHumidity();
+  return !isnan(snap->pressure) && !isnan(snap->humidity);
+}
+
 /*!
  *   Calculates the altitude (in meters) from the specified atmospheric
  *   pressure (in hPa), and sea-level pressure (in hPa).
@@ -105,6 +105,15 @@ typedef struct {
 } bme280_calib_data;
 /*=========================================================================*/
 
+/*!
+ *  @brief  Temperature, pressure and humidity from one measurement
+ */
+typedef struct {
+  float temperature; ///< Celsius
+  float pressure;    ///< Pascals
+  float humidity;    ///< Percent relative humidity
+} bme280_snapshot_t;
+
 class Adafruit_BME280;
 
 /** Adafruit Unified Sensor interface for temperature component of BME280 */
@@ -226,9 +235,12 @@ public:
                    standby_duration duration = STANDBY_MS_0_5);
 
   bool takeForcedMeasurement(void);
+  bool startForcedMeasurement(void);
+  uint32_t measurementTime(void);
   float readTemperature(void);
   float readPressure(void);
   float readHumidity(void);
+  bool snapshot(bme280_snapshot_t *snap);
 
   float readAltitude(float seaLevel);
   float seaLevelForAltitude(float altitude, float pressure);
@@ -256,6 +268,8 @@ protected:
 
   void readCoefficients(void);
   bool isReadingCalibration(void);
+  float compensatePressure(void);
+  float compensateHumidity(void);
   uint8_t spixfer(uint8_t x);
 
   void write8(byte reg, byte value);
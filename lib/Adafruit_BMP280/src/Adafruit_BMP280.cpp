@@ -339,11 +339,20 @@ float Adafruit_BMP280::readTemperature() {
  * @return Barometric pressure in Pa.
  */
 float Adafruit_BMP280::readPressure() {
-  int64_t var1, var2, p;
-
   // Must be done first to get the t_fine variable set up
   readTemperature();
 
+  return compensatePressure();
+}
+
+/*!
+ * Reads the barometric pressure and compensates it with the t_fine from the
+ * last readTemperature().
+ * @return Barometric pressure in Pa.
+ */
+float Adafruit_BMP280::compensatePressure() {
+  int64_t var1, var2, p;
+
   int32_t adc_P = read24(BMP280_REGISTER_PRESSUREDATA);
   adc_P >>= 4;
 
@@ -368,6 +377,18 @@ float Adafruit_BMP280::readPressure() {
   return (float)p / 256;
 }
 
+/*!
+ * Reads temperature and pressure from the same measurement, reading the
+ * temperature once for t_fine.
+ * @param snap Where to store the values
+ * @return true if the values are valid
+ */
+bool Adafruit_BMP280::snapshot(bmp280_snapshot_t *snap) {
+  snap->temperature = readTemperature();
+  snap->pressure = compensatePressure();
+  return !isnan(snap->temperature) && !isnan(snap->pressure);
+}
+
 /*!
  * @brief Calculates the approximate altitude using barometric pressure and the
  * supplied sea level hPa as a reference.
@@ -438,6 +459,31 @@ void Adafruit_BMP280::takeForcedMeasurement()
 }
 
 
+/*!
+ * Start a measurement in forced mode without waiting on it. The values can be
+ * read after measurementTime().
+ * @return true if in forced mode and the measurement was started
+ */
+bool Adafruit_BMP280::startForcedMeasurement() {
+  if (_measReg.mode != MODE_FORCED) {
+    return false;
+  }
+  write8(BMP280_REGISTER_CONTROL, _measReg.get());
+  return true;
+}
+
+/*!
+ * Maximum time one measurement takes with the current oversampling, from the
+ * datasheet, 3.8.1
+ * @return microseconds
+ */
+uint32_t Adafruit_BMP280::measurementTime() {
+  uint32_t t = (_measReg.osrs_t) ? (1 << (_measReg.osrs_t - 1)) : 0;
+  uint32_t p = (_measReg.osrs_p) ? (1 << (_measReg.osrs_p - 1)) : 0;
+
+  return 1250 + (2300 * t) + ((p) ? (2300 * p) + 575 : 0);
+}
+
 /*!
  *  @brief  Resets the chip via soft reset
  */
@@ -88,6 +88,12 @@ typedef struct {
 
 class Adafruit_BMP280;
 
+/** Temperature and pressure from one measurement */
+typedef struct {
+  float temperature; ///< Celsius
+  float pressure;    ///< Pascals
+} bmp280_snapshot_t;
+
 /** Adafruit Unified Sensor interface for temperature component of BMP280 */
 class Adafruit_BMP280_Temp : public Adafruit_Sensor {
 public:
@@ -195,6 +201,7 @@ public:
 
   float readTemperature();
   float readPressure(void);
+  bool snapshot(bmp280_snapshot_t *snap);
   float readAltitude(float seaLevelhPa = 1013.25);
   float seaLevelForAltitude(float altitude, float atmospheric);
   float waterBoilingPoint(float pressure);
@@ -204,6 +211,8 @@ public:
 
   // ICDP Uncommented the below - RJB 2021-06-21
   void takeForcedMeasurement();
+  bool startForcedMeasurement();
+  uint32_t measurementTime();
   void setSampling(sensor_mode mode = MODE_NORMAL,
                    sensor_sampling tempSampling = SAMPLING_X16,
                    sensor_sampling pressSampling = SAMPLING_X16,
@@ -244,6 +253,7 @@ private:
   };
 
   void readCoefficients(void);
+  float compensatePressure(void);
   uint8_t spixfer(uint8_t x);
   void write8(byte reg, byte value);
   uint8_t read8(byte reg);
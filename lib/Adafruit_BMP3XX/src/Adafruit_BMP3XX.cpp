@@ -57,6 +57,7 @@ static int8_t cal_crc(uint8_t seed, uint8_t data);
 /**************************************************************************/
 Adafruit_BMP3XX::Adafruit_BMP3XX(void) {
   _meas_end = 0;
+  _sensor_comp = BMP3_PRESS | BMP3_TEMP;
   _filterEnabled = _tempOSEnabled = _presOSEnabled = false;
 }
 
@@ -291,7 +292,7 @@ float Adafruit_BMP3XX::readAltitude(float seaLevel) {
   //  http://forums.adafruit.com/viewtopic.php?f=22&t=58064
 
   float atmospheric = readPressure() / 100.0F;
-  return 44330.0 * (1.0 - pow(atmospheric / seaLevel, 0.1903));
+  return 44330.0F * (1.0F - powf(atmospheric / seaLevel, 0.1903F));
 }
 
 /**************************************************************************/
@@ -305,6 +306,41 @@ float Adafruit_BMP3XX::readAltitude(float seaLevel) {
 */
 /**************************************************************************/
 bool Adafruit_BMP3XX::performReading(void) {
+  if (!startConversion())
+    return false;
+
+  delayMicroseconds(conversionTime());
+
+  return collectReading();
+}
+
+/**************************************************************************/
+/*!
+    @brief Performs one reading and stores both temperature and pressure.
+
+    @param snap Where to store the values
+    @return True on success, False on failure and both values are NAN
+*/
+/**************************************************************************/
+bool Adafruit_BMP3XX::snapshot(bmp3xx_snapshot_t *snap) {
+  if (!performReading()) {
+    snap->temperature = snap->pressure = NAN;
+    return false;
+  }
+  snap->temperature = temperature;
+  snap->pressure = pressure;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief Starts a forced mode conversion and returns without waiting.
+    Collect the result with collectReading() after conversionTime().
+
+    @return True on success, False on failure
+*/
+/**************************************************************************/
+bool Adafruit_BMP3XX::startConversion(void) {
   g_i2c_dev = i2c_dev;
   g_spi_dev = spi_dev;
   int8_t rslt;
@@ -357,6 +393,50 @@ bool Adafruit_BMP3XX::performReading(void) {
   if (rslt != BMP3_OK)
     return false;
 
+  _sensor_comp = sensor_comp;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief Time a forced mode conversion takes with the current oversampling
+    settings, from BMP3xx datasheet section 3.9.2. Typical times plus 10% to
+    cover the maximum.
+
+    @return Microseconds
+*/
+/**************************************************************************/
+uint32_t Adafruit_BMP3XX::conversionTime(void) {
+  uint32_t meas_t = 234;
+
+  if (the_sensor.settings.press_en) {
+    meas_t += BMP3_SETTLE_TIME_PRESS +
+              ((uint32_t)1 << the_sensor.settings.odr_filter.press_os) *
+                  BMP3_ADC_CONV_TIME;
+  }
+  if (the_sensor.settings.temp_en) {
+    meas_t += BMP3_SETTLE_TIME_TEMP +
+              ((uint32_t)1 << the_sensor.settings.odr_filter.temp_os) *
+                  BMP3_ADC_CONV_TIME;
+  }
+  return meas_t + meas_t / 10;
+}
+
+/**************************************************************************/
+/*!
+    @brief Reads the result of a conversion started with startConversion().
+
+    Assigns the internal Adafruit_BMP3XX#temperature & Adafruit_BMP3XX#pressure
+   member variables
+
+    @return True on success, False on failure
+*/
+/**************************************************************************/
+bool Adafruit_BMP3XX::collectReading(void) {
+  g_i2c_dev = i2c_dev;
+  g_spi_dev = spi_dev;
+  int8_t rslt;
+
   /* Variable used to store the compensated data */
   struct bmp3_data data;
 
@@ -365,7 +445,7 @@ bool Adafruit_BMP3XX::performReading(void) {
 #ifdef BMP3XX_DEBUG
   Serial.println(F("Getting sensor data"));
 #endif
-  rslt = bmp3_get_sensor_data(sensor_comp, &data, &the_sensor);
+  rslt = bmp3_get_sensor_data(_sensor_comp, &data, &the_sensor);
   if (rslt != BMP3_OK)
     return false;
 
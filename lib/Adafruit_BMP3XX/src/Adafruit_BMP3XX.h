@@ -38,6 +38,12 @@
  *  Wraps the Bosch library for Arduino usage
  */
 
+/** Temperature and pressure from one conversion */
+typedef struct {
+  float temperature; ///< Celsius
+  float pressure;    ///< Pascals
+} bmp3xx_snapshot_t;
+
 class Adafruit_BMP3XX {
 public:
   Adafruit_BMP3XX();
@@ -60,10 +66,19 @@ public:
   /// Perform a reading in blocking mode
   bool performReading(void);
 
+  /// Start a forced mode conversion, collect it after conversionTime()
+  bool startConversion(void);
+  /// Microseconds a conversion takes with the current settings
+  uint32_t conversionTime(void);
+  /// Read the result of a conversion started with startConversion()
+  bool collectReading(void);
+  /// Perform one reading and store both values
+  bool snapshot(bmp3xx_snapshot_t *snap);
+
   /// Temperature (Celsius) assigned after calling performReading()
-  double temperature;
+  float temperature;
   /// Pressure (Pascals) assigned after calling performReading()
-  double pressure;
+  float pressure;
 
 private:
   Adafruit_I2CDevice *i2c_dev = NULL; ///< Pointer to I2C bus interface
@@ -76,6 +91,7 @@ private:
   int32_t _sensorID;
   int8_t _cs;
   unsigned long _meas_end;
+  uint8_t _sensor_comp;
 
   uint8_t spixfer(uint8_t x);
 
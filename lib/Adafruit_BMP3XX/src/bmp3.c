@@ -119,9 +119,9 @@ static int8_t compensate_data(uint8_t sensor_comp,
  * @param[in] calib_data : Pointer to calibration data structure.
  *
  * @return Compensated temperature data.
- * @retval Compensated temperature data in double.
+ * @retval Compensated temperature data in bmp3_float_t.
  */
-static double compensate_temperature(const struct bmp3_uncomp_data *uncomp_data, struct bmp3_calib_data *calib_data);
+static bmp3_float_t compensate_temperature(const struct bmp3_uncomp_data *uncomp_data, struct bmp3_calib_data *calib_data);
 
 /*!
  * @brief This internal API is used to compensate the pressure data and return
@@ -131,13 +131,13 @@ static double compensate_temperature(const struct bmp3_uncomp_data *uncomp_data,
  * @param[in] calib_data : Pointer to the calibration data structure.
  *
  * @return Compensated pressure data.
- * @retval Compensated pressure data in double.
+ * @retval Compensated pressure data in bmp3_float_t.
  */
-static double compensate_pressure(const struct bmp3_uncomp_data *uncomp_data, const struct bmp3_calib_data *calib_data);
+static bmp3_float_t compensate_pressure(const struct bmp3_uncomp_data *uncomp_data, const struct bmp3_calib_data *calib_data);
 
 /*!
  * @brief This internal API is used to calculate the power functionality for
- * double precision floating point values.
+ * single or double precision floating point values.
  *
  * @param[in] base : Contains the base value.
  * @param[in] power : Contains the power value.
@@ -145,7 +145,7 @@ static double compensate_pressure(const struct bmp3_uncomp_data *uncomp_data, co
  * @return Output of power function.
  * @retval Calculated power function output in float.
  */
-static float pow_bmp3(double base, uint8_t power);
+static float pow_bmp3(bmp3_float_t base, uint8_t power);
 
 #else
 
@@ -2104,7 +2104,7 @@ static uint32_t calculate_press_meas_time(const struct bmp3_dev *dev)
     struct bmp3_odr_filter_settings odr_filter = dev->settings.odr_filter;
 
 #ifdef BMP3_DOUBLE_PRECISION_COMPENSATION
-    double base = 2.0;
+    bmp3_float_t base = 2.0;
     float partial_out;
 #else
     uint8_t base = 2;
@@ -2127,7 +2127,7 @@ static uint32_t calculate_temp_meas_time(const struct bmp3_dev *dev)
     struct bmp3_odr_filter_settings odr_filter = dev->settings.odr_filter;
 
 #ifdef BMP3_DOUBLE_PRECISION_COMPENSATION
-    double base = 2.0;
+    bmp3_float_t base = 2.0;
     float partial_out;
 #else
     uint8_t base = 2;
@@ -2281,68 +2281,68 @@ static void parse_calib_data(const uint8_t *reg_data, struct bmp3_dev *dev)
     struct bmp3_quantized_calib_data *quantized_calib_data = &dev->calib_data.quantized_calib_data;
 
     /* Temporary variable */
-    double temp_var;
+    bmp3_float_t temp_var;
 
     /* 1 / 2^8 */
     temp_var = 0.00390625f;
     reg_calib_data->par_t1 = BMP3_CONCAT_BYTES(reg_data[1], reg_data[0]);
-    quantized_calib_data->par_t1 = ((double)reg_calib_data->par_t1 / temp_var);
+    quantized_calib_data->par_t1 = ((bmp3_float_t)reg_calib_data->par_t1 / temp_var);
     reg_calib_data->par_t2 = BMP3_CONCAT_BYTES(reg_data[3], reg_data[2]);
     temp_var = 1073741824.0f;
-    quantized_calib_data->par_t2 = ((double)reg_calib_data->par_t2 / temp_var);
+    quantized_calib_data->par_t2 = ((bmp3_float_t)reg_calib_data->par_t2 / temp_var);
     reg_calib_data->par_t3 = (int8_t)reg_data[4];
     temp_var = 281474976710656.0f;
-    quantized_calib_data->par_t3 = ((double)reg_calib_data->par_t3 / temp_var);
+    quantized_calib_data->par_t3 = ((bmp3_float_t)reg_calib_data->par_t3 / temp_var);
     reg_calib_data->par_p1 = (int16_t)BMP3_CONCAT_BYTES(reg_data[6], reg_data[5]);
     temp_var = 1048576.0f;
-    quantized_calib_data->par_p1 = ((double)(reg_calib_data->par_p1 - (16384)) / temp_var);
+    quantized_calib_data->par_p1 = ((bmp3_float_t)(reg_calib_data->par_p1 - (16384)) / temp_var);
     reg_calib_data->par_p2 = (int16_t)BMP3_CONCAT_BYTES(reg_data[8], reg_data[7]);
     temp_var = 536870912.0f;
-    quantized_calib_data->par_p2 = ((double)(reg_calib_data->par_p2 - (16384)) / temp_var);
+    quantized_calib_data->par_p2 = ((bmp3_float_t)(reg_calib_data->par_p2 - (16384)) / temp_var);
     reg_calib_data->par_p3 = (int8_t)reg_data[9];
     temp_var = 4294967296.0f;
-    quantized_calib_data->par_p3 = ((double)reg_calib_data->par_p3 / temp_var);
+    quantized_calib_data->par_p3 = ((bmp3_float_t)reg_calib_data->par_p3 / temp_var);
     reg_calib_data->par_p4 = (int8_t)reg_data[10];
     temp_var = 137438953472.0f;
-    quantized_calib_data->par_p4 = ((double)reg_calib_data->par_p4 / temp_var);
+    quantized_calib_data->par_p4 = ((bmp3_float_t)reg_calib_data->par_p4 / temp_var);
     reg_calib_data->par_p5 = BMP3_CONCAT_BYTES(reg_data[12], reg_data[11]);
 
     /* 1 / 2^3 */
     temp_var = 0.125f;
-    quantized_calib_data->par_p5 = ((double)reg_calib_data->par_p5 / temp_var);
+    quantized_calib_data->par_p5 = ((bmp3_float_t)reg_calib_data->par_p5 / temp_var);
     reg_calib_data->par_p6 = BMP3_CONCAT_BYTES(reg_data[14], reg_data[13]);
     temp_var = 64.0f;
-    quantized_calib_data->par_p6 = ((double)reg_calib_data->par_p6 / temp_var);
+    quantized_calib_data->par_p6 = ((bmp3_float_t)reg_calib_data->par_p6 / temp_var);
     reg_calib_data->par_p7 = (int8_t)reg_data[15];
     temp_var = 256.0f;
-    quantized_calib_data->par_p7 = ((double)reg_calib_data->par_p7 / temp_var);
+    quantized_calib_data->par_p7 = ((bmp3_float_t)reg_calib_data->par_p7 / temp_var);
     reg_calib_data->par_p8 = (int8_t)reg_data[16];
     temp_var = 32768.0f;
-    quantized_calib_data->par_p8 = ((double)reg_calib_data->par_p8 / temp_var);
+    quantized_calib_data->par_p8 = ((bmp3_float_t)reg_calib_data->par_p8 / temp_var);
     reg_calib_data->par_p9 = (int16_t)BMP3_CONCAT_BYTES(reg_data[18], reg_data[17]);
     temp_var = 281474976710656.0f;
-    quantized_calib_data->par_p9 = ((double)reg_calib_data->par_p9 / temp_var);
+    quantized_calib_data->par_p9 = ((bmp3_float_t)reg_calib_data->par_p9 / temp_var);
     reg_calib_data->par_p10 = (int8_t)reg_data[19];
     temp_var = 281474976710656.0f;
-    quantized_calib_data->par_p10 = ((double)reg_calib_data->par_p10 / temp_var);
+    quantized_calib_data->par_p10 = ((bmp3_float_t)reg_calib_data->par_p10 / temp_var);
     reg_calib_data->par_p11 = (int8_t)reg_data[20];
     temp_var = 36893488147419103232.0f;
-    quantized_calib_data->par_p11 = ((double)reg_calib_data->par_p11 / temp_var);
+    quantized_calib_data->par_p11 = ((bmp3_float_t)reg_calib_data->par_p11 / temp_var);
 }
 
 /*!
  * @brief This internal API is used to compensate the raw temperature data and
- * return the compensated temperature data in double data type.
+ * return the compensated temperature data in bmp3_float_t data type.
  * for e.g. returns temperature 24.26 deg Celsius
  */
-static double compensate_temperature(const struct bmp3_uncomp_data *uncomp_data, struct bmp3_calib_data *calib_data)
+static bmp3_float_t compensate_temperature(const struct bmp3_uncomp_data *uncomp_data, struct bmp3_calib_data *calib_data)
 {
     uint32_t uncomp_temp = uncomp_data->temperature;
-    double partial_data1;
-    double partial_data2;
+    bmp3_float_t partial_data1;
+    bmp3_float_t partial_data2;
 
-    partial_data1 = (double)(uncomp_temp - calib_data->quantized_calib_data.par_t1);
-    partial_data2 = (double)(partial_data1 * calib_data->quantized_calib_data.par_t2);
+    partial_data1 = (bmp3_float_t)(uncomp_temp - calib_data->quantized_calib_data.par_t1);
+    partial_data2 = (bmp3_float_t)(partial_data1 * calib_data->quantized_calib_data.par_t2);
 
     /* Update the compensated temperature in calib structure since this is
      * needed for pressure calculation */
@@ -2355,23 +2355,23 @@ static double compensate_temperature(const struct bmp3_uncomp_data *uncomp_data,
 
 /*!
  * @brief This internal API is used to compensate the raw pressure data and
- * return the compensated pressure data in double data type.
+ * return the compensated pressure data in bmp3_float_t data type.
  * For e.g. returns pressure in Pascal p = 95305.295 which is 953.05295 hecto pascal
  */
-static double compensate_pressure(const struct bmp3_uncomp_data *uncomp_data, const struct bmp3_calib_data *calib_data)
+static bmp3_float_t compensate_pressure(const struct bmp3_uncomp_data *uncomp_data, const struct bmp3_calib_data *calib_data)
 {
     const struct bmp3_quantized_calib_data *quantized_calib_data = &calib_data->quantized_calib_data;
 
     /* Variable to store the compensated pressure */
-    double comp_press;
+    bmp3_float_t comp_press;
 
     /* Temporary variables used for compensation */
-    double partial_data1;
-    double partial_data2;
-    double partial_data3;
-    double partial_data4;
-    double partial_out1;
-    double partial_out2;
+    bmp3_float_t partial_data1;
+    bmp3_float_t partial_data2;
+    bmp3_float_t partial_data3;
+    bmp3_float_t partial_data4;
+    bmp3_float_t partial_out1;
+    bmp3_float_t partial_out2;
 
     partial_data1 = quantized_calib_data->par_p6 * quantized_calib_data->t_lin;
     partial_data2 = quantized_calib_data->par_p7 * pow_bmp3(quantized_calib_data->t_lin, 2);
@@ -2382,10 +2382,10 @@ static double compensate_pressure(const struct bmp3_uncomp_data *uncomp_data, co
     partial_data3 = quantized_calib_data->par_p4 * pow_bmp3(quantized_calib_data->t_lin, 3);
     partial_out2 = uncomp_data->pressure *
                    (quantized_calib_data->par_p1 + partial_data1 + partial_data2 + partial_data3);
-    partial_data1 = pow_bmp3((double)uncomp_data->pressure, 2);
+    partial_data1 = pow_bmp3((bmp3_float_t)uncomp_data->pressure, 2);
     partial_data2 = quantized_calib_data->par_p9 + quantized_calib_data->par_p10 * quantized_calib_data->t_lin;
     partial_data3 = partial_data1 * partial_data2;
-    partial_data4 = partial_data3 + pow_bmp3((double)uncomp_data->pressure, 3) * quantized_calib_data->par_p11;
+    partial_data4 = partial_data3 + pow_bmp3((bmp3_float_t)uncomp_data->pressure, 3) * quantized_calib_data->par_p11;
     comp_press = partial_out1 + partial_out2 + partial_data4;
 
     return comp_press;
@@ -2395,7 +2395,7 @@ static double compensate_pressure(const struct bmp3_uncomp_data *uncomp_data, co
  * @brief This internal API is used to calculate the power functionality for
  *  floating point values.
  */
-static float pow_bmp3(double base, uint8_t power)
+static float pow_bmp3(bmp3_float_t base, uint8_t power)
 {
     float pow_output = 1;
 
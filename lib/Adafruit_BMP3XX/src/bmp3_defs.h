@@ -104,6 +104,18 @@ extern "C" {
 #define BMP3_DOUBLE_PRECISION_COMPENSATION
 #endif
 
+/**\name Set the below to 0 to do the floating-point compensation in double precision. On an MCU with only a
+ * single precision FPU (Cortex-M4F) double math is done in software. */
+#ifndef BMP3_FLOAT_COMPENSATION
+#define BMP3_FLOAT_COMPENSATION 1
+#endif
+
+#if BMP3_FLOAT_COMPENSATION
+typedef float bmp3_float_t;
+#else
+typedef double bmp3_float_t;
+#endif
+
 /********************************************************/
 /**\name Macro definitions */
 
@@ -786,21 +798,21 @@ struct bmp3_quantized_calib_data
      */
 
     /**@{*/
-    double par_t1;
-    double par_t2;
-    double par_t3;
-    double par_p1;
-    double par_p2;
-    double par_p3;
-    double par_p4;
-    double par_p5;
-    double par_p6;
-    double par_p7;
-    double par_p8;
-    double par_p9;
-    double par_p10;
-    double par_p11;
-    double t_lin;
+    bmp3_float_t par_t1;
+    bmp3_float_t par_t2;
+    bmp3_float_t par_t3;
+    bmp3_float_t par_p1;
+    bmp3_float_t par_p2;
+    bmp3_float_t par_p3;
+    bmp3_float_t par_p4;
+    bmp3_float_t par_p5;
+    bmp3_float_t par_p6;
+    bmp3_float_t par_p7;
+    bmp3_float_t par_p8;
+    bmp3_float_t par_p9;
+    bmp3_float_t par_p10;
+    bmp3_float_t par_p11;
+    bmp3_float_t t_lin;
 
     /**@}*/
 };
@@ -824,10 +836,10 @@ struct bmp3_calib_data
 struct bmp3_data
 {
     /*! Compensated temperature */
-    double temperature;
+    bmp3_float_t temperature;
 
     /*! Compensated pressure */
-    double pressure;
+    bmp3_float_t pressure;
 };
 
 #else
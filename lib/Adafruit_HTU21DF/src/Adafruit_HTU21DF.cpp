@@ -77,14 +77,49 @@ void Adafruit_HTU21DF::reset(void) {
  *         temperature in degrees Celsius or NAN on failure.
  */
 float Adafruit_HTU21DF::readTemperature(void) {
-  // OK lets ready!
-  uint8_t cmd = HTU21DF_READTEMP;
-  if (!i2c_dev->write(&cmd, 1)) {
+  if (!startTemperature()) {
     return NAN;
   }
 
-  delay(50); // add delay between request and actual read!
+  delay(HTU21DF_MEAS_MS); // add delay between request and actual read!
+
+  return collectTemperature();
+}
+
+/**
+ * Performs a single relative humidity conversion.
+ *
+ * @return A single-precision (32-bit) float value indicating the relative
+ *         humidity in percent (0..100.0%).
+ */
+float Adafruit_HTU21DF::readHumidity(void) {
+  if (!startHumidity()) {
+    return NAN;
+  }
+
+  /* Wait a bit for the conversion to complete. */
+  delay(HTU21DF_MEAS_MS);
+
+  return collectHumidity();
+}
+
+/**
+ * Starts a temperature conversion and returns without waiting.
+ * Collect it with collectTemperature() after HTU21DF_MEAS_MS.
+ *
+ * @return True if the command was sent, otherwise false.
+ */
+bool Adafruit_HTU21DF::startTemperature(void) {
+  uint8_t cmd = HTU21DF_READTEMP;
+  return i2c_dev->write(&cmd, 1);
+}
 
+/**
+ * Reads the result of a conversion started with startTemperature().
+ *
+ * @return Temperature in degrees Celsius or NAN on failure.
+ */
+float Adafruit_HTU21DF::collectTemperature(void) {
   uint8_t buf[3];
   if (!i2c_dev->read(buf, 3)) {
     return NAN;
@@ -109,21 +144,22 @@ float Adafruit_HTU21DF::readTemperature(void) {
 }
 
 /**
- * Performs a single relative humidity conversion.
+ * Starts a relative humidity conversion and returns without waiting.
+ * Collect it with collectHumidity() after HTU21DF_MEAS_MS.
  *
- * @return A single-precision (32-bit) float value indicating the relative
- *         humidity in percent (0..100.0%).
+ * @return True if the command was sent, otherwise false.
  */
-float Adafruit_HTU21DF::readHumidity(void) {
-  /* Prepare the I2C request. */
+bool Adafruit_HTU21DF::startHumidity(void) {
   uint8_t cmd = HTU21DF_READHUM;
-  if (!i2c_dev->write(&cmd, 1)) {
-    return NAN;
-  }
-
-  /* Wait a bit for the conversion to complete. */
-  delay(50);
+  return i2c_dev->write(&cmd, 1);
+}
 
+/**
+ * Reads the result of a conversion started with startHumidity().
+ *
+ * @return Relative humidity in percent (0..100.0%) or NAN on failure.
+ */
+float Adafruit_HTU21DF::collectHumidity(void) {
   uint8_t buf[3];
   if (!i2c_dev->read(buf, 3)) {
     return NAN;
@@ -26,6 +26,9 @@
 /** Reset command. */
 #define HTU21DF_RESET (0xFE)
 
+/** Time to wait between starting a conversion and collecting it. */
+#define HTU21DF_MEAS_MS (50)
+
 /**
  * Driver for the Adafruit HTU21DF breakout board.
  */
@@ -36,6 +39,10 @@ public:
   bool begin(TwoWire *theWire = &Wire);
   float readTemperature(void);
   float readHumidity(void);
+  bool startTemperature(void);
+  float collectTemperature(void);
+  bool startHumidity(void);
+  float collectHumidity(void);
   void reset(void);
 
 private:
@@ -160,6 +160,36 @@ void Adafruit_SHT31::readBoth(float *temperature_out, float *humidity_out) {
   *humidity_out = humidity;
 }
 
+/**
+ * Starts a high repeatability measurement and returns without waiting.
+ * Read the result with readMeasurement() after SHT31_MEAS_MS.
+ *
+ * @return True if the command was sent, otherwise false.
+ */
+bool Adafruit_SHT31::startMeasurement(void) {
+  return writeCommand(SHT31_MEAS_HIGHREP);
+}
+
+/**
+ * Reads the result of a measurement started with startMeasurement().
+ *
+ * @param temperature_out  Where to write the temperature float.
+ * @param humidity_out     Where to write the relative humidity float.
+ *
+ * @return True if successful, otherwise false and both values are NAN.
+ */
+bool Adafruit_SHT31::readMeasurement(float *temperature_out,
+                                     float *humidity_out) {
+  if (!collectTempHum()) {
+    *temperature_out = *humidity_out = NAN;
+    return false;
+  }
+
+  *temperature_out = temp;
+  *humidity_out = humidity;
+  return true;
+}
+
 /**
  * Performs a CRC8 calculation on the supplied values.
  *
@@ -199,13 +229,24 @@ static uint8_t crc8(const uint8_t *data, int len) {
  * @return True if successful, otherwise false.
  */
 bool Adafruit_SHT31::readTempHum(void) {
-  uint8_t readbuffer[6];
-
   writeCommand(SHT31_MEAS_HIGHREP);
 
-  delay(20);
+  delay(SHT31_MEAS_MS);
+
+  return collectTempHum();
+}
 
-  i2c_dev->read(readbuffer, sizeof(readbuffer));
+/**
+ * Internal function to read and convert the result of a temp + humidity
+ * measurement.
+ *
+ * @return True if successful, otherwise false.
+ */
+bool Adafruit_SHT31::collectTempHum(void) {
+  uint8_t readbuffer[6];
+
+  if (!i2c_dev->read(readbuffer, sizeof(readbuffer)))
+    return false;
 
   if (readbuffer[2] != crc8(readbuffer, 2) ||
       readbuffer[5] != crc8(readbuffer + 3, 2))
@@ -42,6 +42,7 @@
 #define SHT31_HEATEREN 0x306D     /**< Heater Enable */
 #define SHT31_HEATERDIS 0x3066    /**< Heater Disable */
 #define SHT31_REG_HEATER_BIT 0x0d /**< Status Register Heater Bit */
+#define SHT31_MEAS_MS 20          /**< High Repeatability Measurement Time */
 
 // ICDP Removed for Particle 
 // extern TwoWire Wire; /**< Forward declarations of Wire for board/variant combinations that don't have a default 'Wire' */
@@ -58,6 +59,8 @@ public:
   float readTemperature(void);
   float readHumidity(void);
   void readBoth(float *temperature_out, float *humidity_out);
+  bool startMeasurement(void);
+  bool readMeasurement(float *temperature_out, float *humidity_out);
   uint16_t readStatus(void);
   void reset(void);
   void heater(bool h);
@@ -75,6 +78,7 @@ private:
   float temp;
 
   bool readTempHum(void);
+  bool collectTempHum(void);
   bool writeCommand(uint16_t cmd);
 
   TwoWire *_wire;                     /**< Wire object */
@@ -441,4 +441,82 @@ float Adafruit_VEML7700::autoLux(void) {
   // Serial.println("** AUTO LUX DEBUG **");
 
   return computeLux(ALS, useCorrection);
-}
\ No newline at end of file
+}
+
+static const uint8_t autoGains[] = {VEML7700_GAIN_1_8, VEML7700_GAIN_1_4,
+                                    VEML7700_GAIN_1, VEML7700_GAIN_2};
+static const uint8_t autoIntTimes[] = {VEML7700_IT_25MS,  VEML7700_IT_50MS,
+                                       VEML7700_IT_100MS, VEML7700_IT_200MS,
+                                       VEML7700_IT_400MS, VEML7700_IT_800MS};
+
+/*!
+ *  @brief Start the same gain and integration time search as autoLux()
+ * without blocking. Call autoLuxPoll() between other work until it returns
+ * true, then read autoLuxResult().
+ */
+void Adafruit_VEML7700::autoLuxStart(void) {
+  _autoGain = 0; // start with ALS gain = 1/8
+  _autoIt = 2;   // start with ALS integration time = 100ms
+  _autoDir = 0;
+  setGain(autoGains[_autoGain]);
+  setIntegrationTime(autoIntTimes[_autoIt], false);
+  _autoWait = 2 * getIntegrationTimeValue();
+  _autoState = 1;
+}
+
+/*!
+ *  @brief Milliseconds until autoLuxPoll() can take its next step
+ *  @returns 0 if it can step now or is not running
+ */
+unsigned long Adafruit_VEML7700::autoLuxReadyIn(void) {
+  unsigned long waited = millis() - lastRead;
+
+  if ((_autoState != 1) || (waited >= _autoWait)) {
+    return 0;
+  }
+  return _autoWait - waited;
+}
+
+/*!
+ *  @brief Take the next step of the auto lux search if the current
+ * integration is done. Never waits.
+ *  @returns true when the result is ready
+ */
+bool Adafruit_VEML7700::autoLuxPoll(void) {
+  if (_autoState != 1) {
+    return _autoState == 2;
+  }
+  if (autoLuxReadyIn()) {
+    return false;
+  }
+
+  uint16_t ALS = readALS(false);
+  int oldIt = getIntegrationTimeValue();
+
+  if (_autoDir == 0) {
+    _autoDir = (ALS <= 100) ? 1 : -1;
+  }
+
+  if ((_autoDir > 0) && (ALS <= 100) && !((_autoGain == 3) && (_autoIt == 5))) {
+    // increase first gain and then integration time as needed
+    if (_autoGain < 3) {
+      setGain(autoGains[++_autoGain]);
+      _autoWait = 2 * oldIt;
+    } else {
+      setIntegrationTime(autoIntTimes[++_autoIt], false);
+      _autoWait = oldIt + 2 * getIntegrationTimeValue();
+    }
+    return false;
+  }
+  if ((_autoDir < 0) && (ALS > 10000) && (_autoIt > 0)) {
+    // decrease integration time as needed
+    setIntegrationTime(autoIntTimes[--_autoIt], false);
+    _autoWait = oldIt + 2 * getIntegrationTimeValue();
+    return false;
+  }
+
+  // compute lux using non-linear correction when we came down from high counts
+  _autoLux = computeLux(ALS, _autoDir < 0);
+  _autoState = 2;
+  return true;
+}
@@ -103,6 +103,12 @@ public:
   uint16_t readWhite(bool wait = false);
   float readLux(luxMethod method = VEML_LUX_NORMAL);
 
+  void autoLuxStart(void);
+  bool autoLuxPoll(void);
+  bool autoLuxRunning(void) { return _autoState == 1; }
+  unsigned long autoLuxReadyIn(void);
+  float autoLuxResult(void) { return _autoLux; }
+
 private:
   const float MAX_RES = 0.0036;
   const float GAIN_MAX = 2;
@@ -113,6 +119,13 @@ private:
   void readWait(void);
   unsigned long lastRead;
 
+  uint8_t _autoState = 0;   // 0 idle, 1 running, 2 done
+  uint8_t _autoGain = 0;    // Index into the auto lux gains
+  uint8_t _autoIt = 0;      // Index into the auto lux integration times
+  int8_t _autoDir = 0;      // 0 first read, 1 raising gain/time, -1 lowering
+  unsigned long _autoWait;  // ms from lastRead until the next ALS read
+  float _autoLux = 0;
+
   Adafruit_I2CRegister *ALS_Config, *ALS_Data, *White_Data, *ALS_HighThreshold,
       *ALS_LowThreshold, *Power_Saving, *Interrupt_Status;
   Adafruit_I2CRegisterBits *ALS_Shutdown, *ALS_Interrupt_Enable,
@@ -6,6 +6,76 @@
 # Line Length is limited to 63 characters
 #12345678901234567890123456789012345678901234567890123456789012
 
+# Awake time budget in seconds for a wake, observe, publish,
+# sleep cycle. When exceeded the SSB_AWAKE health bit is set.
+# 0=Disabled
+awake_budget=120
+
+# Performance reporting 0=Off, 1=perf object in SG observation,
+# 2=Daily PERF event, 3=Both
+perf=0
+
+# Current draw in mA used to estimate mAh per cycle and per day
+ma_awake=10.0
+ma_modem=60.0
+ma_sleep=0.5
+
+# Distance early stop. Sampling stops once the MAD (median
+# absolute deviation in mm) of the samples has been <= dg_mad
+# for dg_stable samples in a row, after at least dg_min
+# samples. Noisy readings keep sampling up to dg_max samples
+# (max 240). dg_mad=0 Disabled, always take 60 samples.
+dg_mad=0
+dg_min=8
+dg_stable=4
+dg_max=120
+
+# Distance statistics added to the SG observation and SD log
+# sgmn=min sgmx=max sg10/sg90=percentiles sgmad=MAD
+# sgro=outliers rejected by the median. 0=Off, 1=On
+dg_stats=0
+
+# Distance bursts while sleeping. Wake every dg_burst seconds,
+# modem and display off, take dg_burst_n samples. The
+# observation reports the interval's samples.
+# 0=Disabled, sample once at observation
+dg_burst=0
+dg_burst_n=8
+
+# Rapid reporting. When the distance changes faster than
+# rr_rate mm/min, observe every rr_cadence seconds (must divide
+# 900) with the modem left on. Back to 15m after rr_hold calm
+# observations.
+# rr_rate=0 Disabled
+rr_rate=0
+rr_cadence=60
+rr_hold=4
+
+# BMP280/BME280 forced mode, one conversion per observation and
+# the sensor sleeps in between. 0=Normal mode, converts always
+# Oversampling 1,2,4,8,16 (bmx_osrs_h=0 skips humidity)
+# IIR filter 0=Off,2,4,8,16
+bmx_forced=1
+bmx_osrs_t=16
+bmx_osrs_p=16
+bmx_osrs_h=16
+bmx_filter=0
+
+# Need to Send backlog publishing. 1=Batch observations into
+# SGB events of positional lines, one ack per event. 0=One SG
+# event per observation
+n2s_batch=1
+
+# Compact observations. 1=Publish SGC events, a schema id, the
+# online sensor bits and scaled integers in a fixed order, no
+# keys. The SD log stays JSON. 0=SG JSON events
+sg_compact=0
+
+# Daily SD log in /OBS. 0=JSON lines YYYYMMDD.log, 1=Binary
+# records with a CRC YYYYMMDD.bin, 2=Both. tools/SGLog exports
+# the binary files to CSV or JSON
+sd_log=0
+
 * ======================================================================================================================
 */
 
@@ -13,4 +83,27 @@
  * ======================================================================================================================
  *  Define Global Configuration File Variables
  * ======================================================================================================================
- */
\ No newline at end of file
+ */
+int cf_awake_budget = 120;          // Seconds, awake time budget for one cycle, 0 = Disabled
+int cf_perf = 0;                    // 0=Off, 1=perf object in SG, 2=Daily PERF event, 3=Both
+float cf_ma_awake = 10.0;           // mA awake with modem off
+float cf_ma_modem = 60.0;           // mA awake with modem on
+float cf_ma_sleep = 0.5;            // mA in ULTRA_LOW_POWER sleep
+int cf_dg_mad = 0;                  // mm, distance early stop MAD threshold, 0 = Disabled
+int cf_dg_min = 8;                  // Minimum distance samples before early stop
+int cf_dg_stable = 4;               // Samples in a row with MAD under threshold to stop
+int cf_dg_max = 120;                // Maximum distance samples when readings are noisy
+int cf_dg_stats = 0;                // 0=Off, 1=Distance statistics in SG observation
+int cf_dg_burst = 0;                // Seconds between distance bursts while sleeping, 0 = Disabled
+int cf_dg_burst_n = 8;              // Distance samples per burst
+int cf_rr_rate = 0;                 // mm/min, distance rate of change to enter rapid reporting, 0 = Disabled
+int cf_rr_cadence = 60;             // Seconds between observations in rapid reporting
+int cf_rr_hold = 4;                 // Calm observations before leaving rapid reporting
+int cf_bmx_forced = 1;              // 0=BMP280/BME280 in normal mode, 1=Forced mode, one conversion per observation
+int cf_bmx_osrs_t = 16;             // BMP280/BME280 temperature oversampling 1,2,4,8,16
+int cf_bmx_osrs_p = 16;             // BMP280/BME280 pressure oversampling 1,2,4,8,16
+int cf_bmx_osrs_h = 16;             // BME280 humidity oversampling 0,1,2,4,8,16
+int cf_bmx_filter = 0;              // BMP280/BME280 IIR filter coefficient 0,2,4,8,16
+int cf_n2s_batch = 1;               // 0=N2S sent as SG events, 1=Batched into SGB events
+int cf_sg_compact = 0;              // 0=SG JSON events, 1=Compact SGC events
+int cf_sd_log = 0;                  // 0=JSON daily log, 1=Binary daily log, 2=Both
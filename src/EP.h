@@ -10,8 +10,10 @@
  * ======================================================================================================================
  */
 typedef struct {
-    time32_t ts;         // timestamp of last modification
-    unsigned long n2sfp; // sd need 2 send file position
+    time32_t ts;             // timestamp of last modification
+    unsigned long n2s_head;  // sd need 2 send ring, offset the next record is written at
+    unsigned long n2s_tail;  // sd need 2 send ring, offset of the oldest record not sent
+    unsigned long n2s_count; // sd need 2 send ring, records from tail to head
     unsigned long checksum;
 } EEPROM_NVM;
 EEPROM_NVM eeprom;
@@ -26,7 +28,9 @@ bool eeprom_valid = false;
 unsigned long EEPROM_ChecksumCompute() {
   unsigned long checksum=0;
   checksum += (unsigned long) eeprom.ts;
-  checksum += (unsigned long) eeprom.n2sfp;
+  checksum += (unsigned long) eeprom.n2s_head;
+  checksum += (unsigned long) eeprom.n2s_tail;
+  checksum += (unsigned long) eeprom.n2s_count;
   return (checksum);
 }
 
@@ -64,7 +68,9 @@ bool EEPROM_ChecksumValid() {
 void EEPROM_Reset(time32_t current_time) {
   if (Time.isValid()) {
     eeprom.ts = current_time;
-    eeprom.n2sfp = 0;
+    eeprom.n2s_head = 0;
+    eeprom.n2s_tail = 0;
+    eeprom.n2s_count = 0;
     EEPROM_ChecksumUpdate();
     EEPROM.put(eeprom_address, eeprom);
     Output("EEPROM RESET");
@@ -133,7 +139,13 @@ void EEPROM_Dump() {
   sprintf (Buffer32Bytes, " TS:%lu", eeprom.ts);
   Output (Buffer32Bytes);
 
-  sprintf (Buffer32Bytes, " N2SFP:%lu", eeprom.n2sfp);
+  sprintf (Buffer32Bytes, " N2SH:%lu", eeprom.n2s_head);
+  Output (Buffer32Bytes);
+
+  sprintf (Buffer32Bytes, " N2ST:%lu", eeprom.n2s_tail);
+  Output (Buffer32Bytes);
+
+  sprintf (Buffer32Bytes, " N2SN:%lu", eeprom.n2s_count);
   Output (Buffer32Bytes);
 
   sprintf (Buffer32Bytes, " CS:%lu", eeprom.checksum);
@@ -13,70 +13,65 @@
 bool INFO_Do() {
   char buf[256];
   const char *comma = "";
-  time_t ts = Time.now();
+  FMT_BUF f, fb;
 
   Output("INFO_DO()");
 
   SendSystemInformation = false;
 
-  memset(buf, 0, sizeof(buf));        // holds string of found sensors 
-  memset(msgbuf, 0, sizeof(msgbuf));  // hold the json formatted message we are building for sending.
+  fmt_begin(&fb, buf, sizeof(buf));         // holds string of found sensors 
+  fmt_begin(&f, msgbuf, sizeof(msgbuf));    // hold the json formatted message we are building for sending.
 
-  JSONBufferWriter writer(msgbuf, sizeof(msgbuf)-1);
-  writer.beginObject();
+  fmt_char(&f, '{');
 
-  writer.name("devid").value(System.deviceID());
-  writer.name("devos").value(System.version());
-  writer.name("freemem").value(System.freeMemory());
-  writer.name("uptime").value(System.uptime());
+  fmt_json_string(&f, "devid", System.deviceID().c_str());
+  fmt_json_string(&f, "devos", System.version().c_str());
+  fmt_json_uint(&f, "freemem", System.freeMemory());
+  fmt_json_uint(&f, "uptime", System.uptime());
 
 #if PLATFORM_ID == PLATFORM_ARGON
-  writer.name("type").value("argon");
+  fmt_json_string(&f, "type", "argon");
 #endif
 #if PLATFORM_ID == PLATFORM_BORON
-  writer.name("board").value("boron");
+  fmt_json_string(&f, "board", "boron");
 #endif
 
-  sprintf (Buffer32Bytes, "%d-%02d-%02dT%02d:%02d:%02d",
-    Time.year(ts), Time.month(ts), Time.day(ts),
-    Time.hour(ts), Time.minute(ts), Time.second(ts));
-  writer.name("at").value(Buffer32Bytes);
+  fmt_json_key(&f, "at");
+  fmt_char(&f, '"');
+  fmt_timestamp(&f, Time.now());
+  fmt_char(&f, '"');
 
-  writer.name("ver").value(VERSION_INFO);
-  writer.name("hth").value((int) SystemStatusBits);
+  fmt_json_string(&f, "ver", VERSION_INFO);
+  fmt_json_int(&f, "hth", (int) SystemStatusBits);
 
-  sprintf (Buffer32Bytes,"15m");
-  writer.name("obsi").value(Buffer32Bytes);
+  fmt_json_string(&f, "obsi", "15m");
 
-  sprintf (Buffer32Bytes,"15m");
-  writer.name("obsti").value(Buffer32Bytes);
+  fmt_json_string(&f, "obsti", "15m");
 
   // Time 2 Next Transmit in Seconds
   // sprintf (Buffer32Bytes, "%ds", (int) ((obs_tx_interval * 60) - ((System.millis() - LastTransmitTime)/1000)));
   // writer.name("t2nt").value(Buffer32Bytes);
 
   // Daily Reboot Countdown Timer
-  writer.name("drct").value(DailyRebootCountDownTimer);
+  fmt_json_int(&f, "drct", DailyRebootCountDownTimer);
 
-  // Need 2 Send File
-  if (SD.exists(SD_n2s_file)) {
-    File fp = SD.open(SD_n2s_file, FILE_WRITE);
-    if (fp) {
-      writer.name("n2s").value(fp.size());
-      fp.close();
-    }
-    else {
-      writer.name("n2s").value(-1);
-    }
+  // Awake time of the last cycle and the budget in seconds
+  fmt_json_uint(&f, "awake", perf_awake_last);
+  fmt_json_int(&f, "awkb", cf_awake_budget);
+  fmt_json_int(&f, "perf", cf_perf);
+
+  // Need 2 Send Ring, records waiting to be sent
+  if (SD_exists && eeprom_valid) {
+    fmt_json_uint(&f, "n2s", eeprom.n2s_count);
   }
   else {
-    writer.name("n2s").value("NF");
+    fmt_json_string(&f, "n2s", "NF");
   }
 
 #if PLATFORM_ID == PLATFORM_ARGON
-  writer.name("ps").value((digitalRead(PWR)) ? "USB" : "BATTERY");
-  writer.name("bv").value(analogRead(BATT) * 0.0011224); // Battery Voltage
-  writer.name("bcs").value((digitalRead(PWR) && !digitalRead(CHG)) ? "CHARGING" : "!CHARGING"); // Battery Charger State
+  fmt_json_string(&f, "ps", (digitalRead(PWR)) ? "USB" : "BATTERY");
+  fmt_json_float(&f, "bv", analogRead(BATT) * 0.0011224, 3); // Battery Voltage
+  fmt_json_string(&f, "bcs", (digitalRead(PWR) && !digitalRead(CHG)) ? "CHARGING" : "!CHARGING"); // Battery Charger State
 #endif
 
 #if PLATFORM_ID == PLATFORM_BORON
@@ -84,115 +79,123 @@ bool INFO_Do() {
   const char *ps[] = {"UNKN", "VIN", "USB_HOST", "USB_ADAPTER", "USB_OTG", "BATTERY"};
   int sps = System.powerSource();
   if ((sps>=0) && (sps<=5)) {
-    writer.name("ps").value(ps[sps]);
+    fmt_json_string(&f, "ps", ps[sps]);
   }
   else {
-    writer.name("ps").value(sps);
+    fmt_json_int(&f, "ps", sps);
   }
 
   // Battery Charge State
   const char *bs[] = {"UNKN", "!CHARGING", "CHARGING", "CHARGED", "DISCHARGING", "FAULT", "MISSING"};
   int sbs = System.batteryState();
   if ((sbs>=0) && (sbs<=6)) {
-    writer.name("bcs").value(bs[sbs]);     
+    fmt_json_string(&f, "bcs", bs[sbs]);
   }
   else {
-    writer.name("bcs").value(sbs);
+    fmt_json_int(&f, "bcs", sbs);
   }
-  writer.name("bpc").value(System.batteryCharge(), 1);   // Battery Percent Charge
+  fmt_json_float(&f, "bpc", System.batteryCharge(), 1);   // Battery Percent Charge
 #endif
 
 #if PLATFORM_ID == PLATFORM_ARGON
   WiFiSignal sig = WiFi.RSSI();
-  writer.name("wss").value(sig.getStrength(), 4);
-  writer.name("wsq").value(sig.getQuality(), 4);
+  fmt_json_float(&f, "wss", sig.getStrength(), 4);
+  fmt_json_float(&f, "wsq", sig.getQuality(), 4);
   byte mac[6];
   WiFi.macAddress(mac);
   sprintf (Buffer32Bytes, "%02x:%02x:%02x:%02x:%02x:%02x", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-  writer.name("mac").value(Buffer32Bytes);
-  writer.name("ip").value(WiFi.localIP().toString().c_str());
-  writer.name("mask").value(WiFi.subnetMask().toString().c_str());
-  writer.name("gateway").value(WiFi.gatewayIP().toString().c_str());
-  writer.name("dns").value(WiFi.dnsServerIP().toString().c_str());
-  writer.name("dhcps").value(WiFi.dhcpServerIP().toString().c_str());
-  writer.name("ssid").value(WiFi.SSID());
+  fmt_json_string(&f, "mac", Buffer32Bytes);
+  fmt_json_string(&f, "ip", WiFi.localIP().toString().c_str());
+  fmt_json_string(&f, "mask", WiFi.subnetMask().toString().c_str());
+  fmt_json_string(&f, "gateway", WiFi.gatewayIP().toString().c_str());
+  fmt_json_string(&f, "dns", WiFi.dnsServerIP().toString().c_str());
+  fmt_json_string(&f, "dhcps", WiFi.dhcpServerIP().toString().c_str());
+  fmt_json_string(&f, "ssid", WiFi.SSID());
   WiFi.BSSID(mac);
   sprintf (Buffer32Bytes, "%02x:%02x:%02x:%02x:%02x:%02x", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-  writer.name("bssid").value(Buffer32Bytes);
+  fmt_json_string(&f, "bssid", Buffer32Bytes);
 #endif
 
 #if PLATFORM_ID == PLATFORM_BORON
   CellularSignal sig = Cellular.RSSI();
-  writer.name("css").value(sig.getStrength(), 4);
-  writer.name("csq").value(sig.getQuality(), 4);
+  fmt_json_float(&f, "css", sig.getStrength(), 4);
+  fmt_json_float(&f, "csq", sig.getQuality(), 4);
 
   SimType simType = Cellular.getActiveSim();
   if (simType == INTERNAL_SIM) {
-    writer.name("actsim").value("INTERNAL");
+    fmt_json_string(&f, "actsim", "INTERNAL");
   } else if (simType == EXTERNAL_SIM) {
-    writer.name("actsim").value("EXTERNAL");
+    fmt_json_string(&f, "actsim", "EXTERNAL");
   } else {
-    writer.name("actsim").value("ERR");
+    fmt_json_string(&f, "actsim", "ERR");
   }
 #endif
 
   if (dg_adjustment == 1.25) {
-    writer.name("a3").value("DIST 5M");
+    fmt_json_string(&f, "a3", "DIST 5M");
   }
   else {
-    writer.name("a3").value("DIST 10M");
+    fmt_json_string(&f, "a3", "DIST 10M");
   }
 
   // Sensors
-  if (BMX_1_exists) {
-    sprintf (buf+strlen(buf), "%sBMX1(%s)", comma, bmxtype[BMX_1_type]);
-    comma=",";
-  }
-  if (BMX_2_exists) {
-    sprintf (buf+strlen(buf), "%sBMX2(%s)", comma, bmxtype[BMX_2_type]);
-    comma=",";
-  }
-  if (MCP_1_exists) {
-    sprintf (buf+strlen(buf), "%sMCP1", comma);
-    comma=",";
-  }
-  if (MCP_2_exists) {
-    sprintf (buf+strlen(buf), "%sMCP2", comma);
-    comma=",";
-  }
-  if (SHT_1_exists) {
-    sprintf (buf+strlen(buf), "%sSHT1", comma);
-    comma=",";
-  }
-  if (SHT_2_exists) {
-    sprintf (buf+strlen(buf), "%sSHT2", comma);
-    comma=",";
-  }
-  if (HIH8_exists) {
-    sprintf (buf+strlen(buf), "%sHIH8", comma);
-    comma=",";
-  }
-  if (SI1145_exists) {
-    sprintf (buf+strlen(buf), "%sSI", comma);
-    comma=",";
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    if (*sensors[i].exists) {
+      fmt_str(&fb, comma);
+      fmt_str(&fb, sensors[i].name);
+      if (sensors[i].type) {
+        fmt_char(&fb, '(');
+        fmt_str(&fb, bmxtype[*sensors[i].type]);
+        fmt_char(&fb, ')');
+      }
+      comma=",";
+    }
   }
-  if (VEML7700_exists) {
-    sprintf (buf+strlen(buf), "%sVEML", comma);
-    comma=",";
+  fmt_json_string(&f, "sensors", buf);
+
+  // Schema of the positional SGB and SGC lines, the sensors above are the online bits
+  fmt_json_int(&f, "sgs", N2S_SCHEMA);
+  fmt_json_int(&f, "sgc", cf_sg_compact);
+
+  // I2C counters by address - count,nacks,timeouts,latency histogram. Addresses that do not fit in buf are left out.
+  fmt_begin(&fb, buf, sizeof(buf));
+  comma = "";
+  for (int i=0; i<i2c_stats_n; i++) {
+    I2C_STATS *st = &i2c_stats[i];
+    size_t mark = fb.len;
+
+    fmt_str(&fb, comma);
+    fmt_hex(&fb, st->address, 2);
+    fmt_char(&fb, ':');
+    fmt_uint(&fb, st->count);
+    fmt_char(&fb, ',');
+    fmt_uint(&fb, st->nacks);
+    fmt_char(&fb, ',');
+    fmt_uint(&fb, st->timeouts);
+    for (int h=0; h<I2C_HIST; h++) {
+      fmt_char(&fb, (h) ? '.' : ',');
+      fmt_uint(&fb, st->hist[h]);
+    }
+    if (fmt_overflow(&fb)) {
+      buf[mark] = 0; // Back to the last complete address
+      break;
+    }
+    comma=";";
   }
-  writer.name("sensors").value(buf);
+  fmt_json_string(&f, "i2c", buf);
+  fmt_json_uint(&f, "i2cr", i2c_recoveries);
 
   // Oled Display
   if (oled_type) {
-    writer.name("oled").value(OLED32 ? "32" : "64");
+    fmt_json_string(&f, "oled", OLED32 ? "32" : "64");
   }
   else {
-    writer.name("oled").value("NF");
+    fmt_json_string(&f, "oled", "NF");
   }
-  writer.name("scepin").value((digitalRead(SCE_PIN)) ? "DISABLED" : "ENABLED");
-  writer.name("sce").value((SerialConsoleEnabled) ? "TRUE" : "FALSE");
+  fmt_json_string(&f, "scepin", (digitalRead(SCE_PIN)) ? "DISABLED" : "ENABLED");
+  fmt_json_string(&f, "sce", (SerialConsoleEnabled) ? "TRUE" : "FALSE");
 
-  writer.endObject();
+  fmt_char(&f, '}');
 
   // Done profiling system
 
@@ -202,6 +205,7 @@ bool INFO_Do() {
     if (fp) {
       fp.println(msgbuf);
       fp.close();
+      PERF_SDWrite(strlen(msgbuf)+2);
       SystemStatusBits &= ~SSB_SD;  // Turn Off Bit
       // Output ("INFO Logged to SD");
     }
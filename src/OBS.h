@@ -4,6 +4,452 @@
  * ======================================================================================================================
  */
 
+/*
+ * ======================================================================================================================
+ *  Observation Record
+ *
+ *  OBS_Do() reads the distance gauge, sensors and modem once per cycle into an OBS_RECORD. The SG publish, the SD
+ *  log, the N2S record and the OLED summary lines are all rendered from the record, so they can not drift apart.
+ *  The record is packed and starts with OBS_VERSION so it can also be stored as is. It records which optional
+ *  distance fields and which sensors were present when observed, so a stored record renders like a live one.
+ * ======================================================================================================================
+ */
+#define OBS_VERSION        1
+#define OBS_F_SGN       0x01    // sgn present, cf_dg_mad was set
+#define OBS_F_SGRR      0x02    // sgrr present, cf_rr_rate was set
+#define OBS_F_STATS     0x04    // Distance sample statistics present, cf_dg_stats was set
+
+typedef struct __attribute__((packed)) {
+  uint8_t  version;                   // OBS_VERSION
+  uint8_t  flags;                     // OBS_F_* optional fields present
+  uint32_t ts;                        // Observation time, seconds since 1970
+  uint16_t sg;                        // Distance median
+  uint16_t sgn;                       // Samples in the median
+  float    sgrr;                      // Rate of change
+  uint16_t sgmn;                      // Distance sample statistics
+  uint16_t sgmx;
+  uint16_t sg10;
+  uint16_t sg90;
+  uint16_t sgmad;
+  uint16_t sgro;
+  uint16_t online;                    // Bit per sensors[] entry online when observed
+  float    sv[SENSOR_COUNT][SV_MAX];  // Sensor values in descriptor table order
+  int8_t   bcs;                       // Battery charger state
+  float    bpc;                       // Battery percent of charge
+  uint8_t  cfr;                       // Battery charger fault register
+  float    css;                       // Cell or WiFi signal strength
+  uint32_t hth;                       // SystemStatusBits
+} OBS_RECORD;
+
+static_assert(SENSOR_COUNT <= 16, "OBS_RECORD online bits");
+
+/*
+ * ======================================================================================================================
+ * OBS_JSON() - Render an observation record into msgbuf, with the perf object when asked for
+ * ======================================================================================================================
+ */
+void OBS_JSON(OBS_RECORD *obs, bool perf) {
+  FMT_BUF f;
+
+  fmt_begin(&f, msgbuf, sizeof(msgbuf));
+  fmt_char(&f, '{');
+    fmt_json_key(&f, "at");
+    fmt_char(&f, '"');
+    fmt_timestamp(&f, obs->ts);
+    fmt_char(&f, '"');
+    fmt_json_uint(&f, "sg", obs->sg);
+    if (obs->flags & OBS_F_SGN) {
+      fmt_json_uint(&f, "sgn", obs->sgn);
+    }
+    if (obs->flags & OBS_F_SGRR) {
+      fmt_json_float(&f, "sgrr", obs->sgrr, 1);
+    }
+    if (obs->flags & OBS_F_STATS) {
+      fmt_json_uint(&f, "sgmn", obs->sgmn);
+      fmt_json_uint(&f, "sgmx", obs->sgmx);
+      fmt_json_uint(&f, "sg10", obs->sg10);
+      fmt_json_uint(&f, "sg90", obs->sg90);
+      fmt_json_uint(&f, "sgmad", obs->sgmad);
+      fmt_json_uint(&f, "sgro", obs->sgro);
+    }
+
+    for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+      if (obs->online & (1 << i)) {
+        for (int j=0; j<sensors[i].nv; j++) {
+          fmt_json_float(&f, sensors[i].key[j], obs->sv[i][j], sensors[i].precision[j]);
+        }
+      }
+    }
+
+    fmt_json_int(&f, "bcs", obs->bcs);
+    fmt_json_float(&f, "bpc", obs->bpc, 4);
+    fmt_json_uint(&f, "cfr", obs->cfr);
+    fmt_json_float(&f, "css", obs->css, 4);
+    fmt_json_uint(&f, "hth", obs->hth);
+
+    // Awake time and energy of the last completed cycle
+    if (perf && (cf_perf & 1) && perf_last.cycles) {
+      fmt_json_object(&f, "perf");
+        PERF_JSON(&f, &perf_last);
+      fmt_char(&f, '}');
+    }
+  fmt_char(&f, '}');
+}
+
+/*
+ * ======================================================================================================================
+ *  Need to Send Record
+ *
+ *  Observations that fail to publish are stored in the N2S file as binary records and rendered to JSON only when
+ *  they are published. A record is
+ *    schema, length, flags, ts, online, sg, [sgn], [sgrr], [sgmn sgmx sg10 sg90 sgmad sgro],
+ *    the values of each online sensor in sensors[] order, bcs, bpc, cfr, css, hth
+ *  little endian, with the optional fields per flags. A typical record is 40 to 60 bytes against 250 to 400 for the
+ *  JSON line. The sensor values follow the descriptor table, so N2S_SCHEMA must change when the table does.
+ * ======================================================================================================================
+ */
+#define N2S_SCHEMA      1
+#define N2S_MIN        25                       // Record with no optional fields and no sensors
+#define N2S_TAIL       14                       // bcs, bpc, cfr, css, hth
+#define N2S_MAX        (sizeof(OBS_RECORD) + 2)
+
+static_assert(N2S_MAX <= N2S_REC_MAX, "N2S record length is one byte");
+
+#define N2S_PUT(p, v)  { memcpy(p, &(v), sizeof(v)); p += sizeof(v); }
+#define N2S_GET(p, v)  { memcpy(&(v), p, sizeof(v)); p += sizeof(v); }
+
+/*
+ * ======================================================================================================================
+ * OBS_N2SEncode() - Pack an observation record into an N2S record, return its length
+ * ======================================================================================================================
+ */
+int OBS_N2SEncode(OBS_RECORD *obs, uint8_t *rec) {
+  uint8_t *p = rec + N2S_HDR;
+
+  N2S_PUT(p, obs->flags);
+  N2S_PUT(p, obs->ts);
+  N2S_PUT(p, obs->online);
+  N2S_PUT(p, obs->sg);
+  if (obs->flags & OBS_F_SGN) {
+    N2S_PUT(p, obs->sgn);
+  }
+  if (obs->flags & OBS_F_SGRR) {
+    N2S_PUT(p, obs->sgrr);
+  }
+  if (obs->flags & OBS_F_STATS) {
+    N2S_PUT(p, obs->sgmn);
+    N2S_PUT(p, obs->sgmx);
+    N2S_PUT(p, obs->sg10);
+    N2S_PUT(p, obs->sg90);
+    N2S_PUT(p, obs->sgmad);
+    N2S_PUT(p, obs->sgro);
+  }
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    if (obs->online & (1 << i)) {
+      for (int j=0; j<sensors[i].nv; j++) {
+        N2S_PUT(p, obs->sv[i][j]);
+      }
+    }
+  }
+  N2S_PUT(p, obs->bcs);
+  N2S_PUT(p, obs->bpc);
+  N2S_PUT(p, obs->cfr);
+  N2S_PUT(p, obs->css);
+  N2S_PUT(p, obs->hth);
+
+  rec[0] = N2S_SCHEMA;
+  rec[1] = p - rec;
+  return (rec[1]);
+}
+
+/*
+ * ======================================================================================================================
+ * OBS_N2SDecode() - Unpack an N2S record into an observation record, false if the record is not valid
+ * ======================================================================================================================
+ */
+bool OBS_N2SDecode(uint8_t *rec, int len, OBS_RECORD *obs) {
+  uint8_t *p = rec + N2S_HDR;
+
+  if ((len < N2S_MIN) || (len > (int) N2S_MAX) || (rec[0] != N2S_SCHEMA) || (rec[1] != len)) {
+    return (false);
+  }
+
+  memset(obs, 0, sizeof(OBS_RECORD));
+  obs->version = OBS_VERSION;
+  N2S_GET(p, obs->flags);
+  N2S_GET(p, obs->ts);
+  N2S_GET(p, obs->online);
+  N2S_GET(p, obs->sg);
+  if (obs->flags & OBS_F_SGN) {
+    N2S_GET(p, obs->sgn);
+  }
+  if (obs->flags & OBS_F_SGRR) {
+    N2S_GET(p, obs->sgrr);
+  }
+  if (obs->flags & OBS_F_STATS) {
+    N2S_GET(p, obs->sgmn);
+    N2S_GET(p, obs->sgmx);
+    N2S_GET(p, obs->sg10);
+    N2S_GET(p, obs->sg90);
+    N2S_GET(p, obs->sgmad);
+    N2S_GET(p, obs->sgro);
+  }
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    if (obs->online & (1 << i)) {
+      if ((p - rec) + (sensors[i].nv * sizeof(float)) + N2S_TAIL > (unsigned int) len) {
+        return (false);
+      }
+      for (int j=0; j<sensors[i].nv; j++) {
+        N2S_GET(p, obs->sv[i][j]);
+      }
+    }
+  }
+  if ((p - rec) + N2S_TAIL != len) {
+    return (false);
+  }
+  N2S_GET(p, obs->bcs);
+  N2S_GET(p, obs->bpc);
+  N2S_GET(p, obs->cfr);
+  N2S_GET(p, obs->css);
+  N2S_GET(p, obs->hth);
+  return (true);
+}
+
+/*
+ * ======================================================================================================================
+ * OBS_N2SValid() - True if an N2S record decodes
+ * ======================================================================================================================
+ */
+bool OBS_N2SValid(uint8_t *rec, int len) {
+  OBS_RECORD obs;
+
+  return (OBS_N2SDecode(rec, len, &obs));
+}
+
+/*
+ * ======================================================================================================================
+ * OBS_N2S_JSON() - Render an N2S record into msgbuf for publishing
+ * ======================================================================================================================
+ */
+bool OBS_N2S_JSON(uint8_t *rec, int len) {
+  OBS_RECORD obs;
+
+  if (!OBS_N2SDecode(rec, len, &obs)) {
+    return (false);
+  }
+  OBS_JSON(&obs, false);
+  return (true);
+}
+
+/*
+ * ======================================================================================================================
+ *  Binary Daily Log
+ *
+ *  With sd_log 1 or 2 each observation is appended to /OBS/YYYYMMDD.bin as its N2S record followed by a CRC-16 of
+ *  the record. A new file starts with a header that describes the records, so the host tool needs no copy of the
+ *  sensor table
+ *    "SGLB", version, N2S_SCHEMA, sensor count, 0, header length (u16), VERSION_INFO (24 bytes)
+ *    per sensor: name (6 bytes), nv, then SV_MAX times key (6 bytes) and precision
+ *    CRC-16 of the header
+ *  Strings are null padded and numbers little endian. tools/SGLog exports the files to CSV or JSON.
+ * ======================================================================================================================
+ */
+#define LOG_VERSION     1
+#define LOG_NAME_LEN    6
+#define LOG_KEY_LEN     6
+#define LOG_VER_LEN     24
+#define LOG_HDR_FIXED   (10 + LOG_VER_LEN)
+#define LOG_HDR_SENSOR  (LOG_NAME_LEN + 1 + SV_MAX * (LOG_KEY_LEN + 1))
+#define LOG_HDR_MAX     (LOG_HDR_FIXED + SENSOR_COUNT * LOG_HDR_SENSOR + 2)
+
+static_assert(LOG_HDR_MAX <= LOG_HDR_BUF, "Binary daily log header buffer");
+
+/*
+ * ======================================================================================================================
+ * OBS_LogHeader() - Build the binary daily log file header, return its length
+ * ======================================================================================================================
+ */
+int OBS_LogHeader(uint8_t *hdr) {
+  uint8_t *p = hdr;
+  uint16_t len = LOG_HDR_MAX;
+  uint16_t crc;
+
+  memset(hdr, 0, LOG_HDR_MAX);
+  memcpy(p, "SGLB", 4);
+  p += 4;
+  *p++ = LOG_VERSION;
+  *p++ = N2S_SCHEMA;
+  *p++ = SENSOR_COUNT;
+  *p++ = 0;
+  N2S_PUT(p, len);
+  strncpy((char *) p, VERSION_INFO, LOG_VER_LEN-1);
+  p += LOG_VER_LEN;
+
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    strncpy((char *) p, sensors[i].name, LOG_NAME_LEN-1);
+    p += LOG_NAME_LEN;
+    *p++ = sensors[i].nv;
+    for (int j=0; j<SV_MAX; j++) {
+      if (j < sensors[i].nv) {
+        strncpy((char *) p, sensors[i].key[j], LOG_KEY_LEN-1);
+        p[LOG_KEY_LEN] = sensors[i].precision[j];
+      }
+      p += LOG_KEY_LEN + 1;
+    }
+  }
+
+  crc = crc16(hdr, p - hdr);
+  N2S_PUT(p, crc);
+  return (p - hdr);
+}
+
+/*
+ * ======================================================================================================================
+ *  Positional Observation Line
+ *
+ *  Batched N2S events (SGB) and compact observations (SGC, cf_sg_compact) carry observations as positional lines
+ *  of integers, separated by ';' after the N2S_SCHEMA the lines follow. The schema fixes the sensors[] order, keys
+ *  and precision, and the online bits say which sensors have values. Fields are in N2S record order
+ *    dt,flags,online,sg,[sgn],[sgrr],[sgmn,sgmx,sg10,sg90,sgmad,sgro],values,bcs,bpc,cfr,css,hth
+ *  dt is signed seconds since the previous line in the event, negative when the RTC was set back between two
+ *  records. The first line has the observation time. Floats are scaled and rounded with fmt_scale(), sgrr by 10,
+ *  sensor values by 10^ their JSON precision, bpc and css by 10000.
+ *  tools/SGDecode turns these events back into the SG JSON.
+ * ======================================================================================================================
+ */
+
+/*
+ * ======================================================================================================================
+ * OBS_LineAdd() - Add a field after the first to a positional line
+ * ======================================================================================================================
+ */
+void OBS_LineAdd(FMT_BUF *f, int32_t v) {
+  fmt_char(f, ',');
+  fmt_int(f, v);
+}
+
+/*
+ * ======================================================================================================================
+ * OBS_Line() - Append an observation record as a positional line
+ * ======================================================================================================================
+ */
+void OBS_Line(OBS_RECORD *obs, FMT_BUF *f, uint32_t ts_prev) {
+  if (ts_prev) {
+    fmt_int(f, (int32_t) (obs->ts - ts_prev));
+  }
+  else {
+    fmt_uint(f, obs->ts);
+  }
+  OBS_LineAdd(f, obs->flags);
+  OBS_LineAdd(f, obs->online);
+  OBS_LineAdd(f, obs->sg);
+  if (obs->flags & OBS_F_SGN) {
+    OBS_LineAdd(f, obs->sgn);
+  }
+  if (obs->flags & OBS_F_SGRR) {
+    OBS_LineAdd(f, fmt_scale(obs->sgrr, 1));
+  }
+  if (obs->flags & OBS_F_STATS) {
+    OBS_LineAdd(f, obs->sgmn);
+    OBS_LineAdd(f, obs->sgmx);
+    OBS_LineAdd(f, obs->sg10);
+    OBS_LineAdd(f, obs->sg90);
+    OBS_LineAdd(f, obs->sgmad);
+    OBS_LineAdd(f, obs->sgro);
+  }
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    if (obs->online & (1 << i)) {
+      for (int j=0; j<sensors[i].nv; j++) {
+        OBS_LineAdd(f, fmt_scale(obs->sv[i][j], sensors[i].precision[j]));
+      }
+    }
+  }
+  OBS_LineAdd(f, obs->bcs);
+  OBS_LineAdd(f, fmt_scale(obs->bpc, 4));
+  OBS_LineAdd(f, obs->cfr);
+  OBS_LineAdd(f, fmt_scale(obs->css, 4));
+  fmt_char(f, ',');
+  fmt_uint(f, obs->hth);    // All 32 bits, OBS_LineAdd() would write bit 31 as a sign
+}
+
+/*
+ * ======================================================================================================================
+ * OBS_N2S_Append() - Add an N2S record to the SGB event in msgbuf. 1 added, 0 msgbuf is full, -1 record not valid
+ * ======================================================================================================================
+ */
+int OBS_N2S_Append(uint8_t *rec, int len, int max, uint32_t *ts_prev) {
+  OBS_RECORD obs;
+  char line[OBS_LINE_MAX];
+  FMT_BUF f;
+  int used;
+
+  if (!OBS_N2SDecode(rec, len, &obs)) {
+    return (-1);
+  }
+  fmt_begin(&f, line, sizeof(line));
+  OBS_Line(&obs, &f, *ts_prev);
+  if (fmt_overflow(&f)) {
+    return (-1);
+  }
+
+  used = strlen(msgbuf);
+  if (used == 0) {
+    FMT_BUF m;
+    fmt_begin(&m, msgbuf, sizeof(msgbuf));
+    fmt_uint(&m, N2S_SCHEMA);
+    used = m.len;
+  }
+  if (used + 1 + (int) f.len > max) {
+    return (0);
+  }
+  msgbuf[used] = ';';
+  strcpy (&msgbuf[used+1], line);
+  *ts_prev = obs.ts;
+  return (1);
+}
+
+/*
+ * ======================================================================================================================
+ * OBS_Compact() - Render an observation record into msgbuf as a compact SGC event
+ * ======================================================================================================================
+ */
+void OBS_Compact(OBS_RECORD *obs) {
+  FMT_BUF f;
+
+  fmt_begin(&f, msgbuf, sizeof(msgbuf));
+  fmt_uint(&f, N2S_SCHEMA);
+  fmt_char(&f, ';');
+  OBS_Line(obs, &f, 0);
+}
+
+/*
+ * ======================================================================================================================
+ * OBS_Display() - Output the observation summary lines
+ * ======================================================================================================================
+ */
+void OBS_Display(OBS_RECORD *obs) {
+  FMT_BUF f;
+
+  fmt_begin(&f, msgbuf, sizeof(msgbuf));
+  fmt_uint(&f, obs->sg);
+  fmt_char(&f, ' ');
+  fmt_float(&f, obs->sv[0][0], 2);      // bp1, bp2 are the first table entries
+  fmt_char(&f, ' ');
+  fmt_float(&f, obs->sv[1][0], 2);
+  Output(msgbuf);
+
+  fmt_begin(&f, msgbuf, sizeof(msgbuf));
+  fmt_char(&f, 'C');
+  fmt_float(&f, obs->css, 2);
+  fmt_str(&f, " B");
+  fmt_int(&f, obs->bcs);
+  fmt_char(&f, ':');
+  fmt_float(&f, obs->bpc, 2);
+  fmt_char(&f, ' ');
+  fmt_hex(&f, obs->hth, 4);
+  Output(msgbuf);
+}
+
 /*
  * ======================================================================================================================
  * Particle_Publish() - Publish to Particle what is in msgbuf
@@ -18,6 +464,8 @@ bool Particle_Publish(char *EventName) {
   // if (Cellular.ready() && Particle.connected()) {
   if (Particle.connected()) {
     if (Particle.publish(EventName, msgbuf,  WITH_ACK)) {  // PRIVATE flag is always used even when not specified
+      PERF_Published(EventName, msgbuf);
+
       // Currently, a device can publish at rate of about 1 event/sec, with bursts of up to 4 allowed in 1 second. 
       delay (1000);
       return(true);
@@ -35,26 +483,10 @@ bool Particle_Publish(char *EventName) {
  * ======================================================================================================================
  */
 void OBS_Do() {
-  float bmx1_pressure = 0.0;
-  float bmx1_temp = 0.0;
-  float bmx1_humid = 0.0;
-  float bmx2_pressure = 0.0;
-  float bmx2_temp = 0.0;
-  float bmx2_humid = 0.0;
-  float htu1_temp = 0.0;
-  float htu1_humid = 0.0;
-  float mcp1_temp = 0.0;
-  float mcp2_temp = 0.0;
-  float st1 = 0.0;
-  float sh1 = 0.0;
-  float st2 = 0.0;
-  float sh2 = 0.0;
-  float ht2 = 0.0; // HIH8
-  float hh2 = 0.0; // HIH8
-  float lux = 0.0;
-  float si_vis = 0.0;
-  float si_ir = 0.0;
-  float si_uv = 0.0;
+  OBS_RECORD obs;
+  float sv[SENSOR_COUNT][SV_MAX];       // Sensor values in descriptor table order
+  uint8_t rec[N2S_MAX];                 // Binary record for the SD log and N2S file
+  int len;
 
   // Safty Check for Vaild Time
   if (!Time.isValid()) {
@@ -62,246 +494,98 @@ void OBS_Do() {
     return;
   }
 
+  memset(&obs, 0, sizeof(obs));
+  obs.version = OBS_VERSION;
+
   // Take multiple readings and return the median
+  PERF_Phase(PERF_DISTANCE);
   int OD_Median = distance_gauge_median();
-  int BatteryState = 0;
-  float BatteryPoC = 0.0;                 // Battery Percent of Charge
-  byte cfr = 0;
-
-  // Adafruit I2C Sensors
-  if (BMX_1_exists) {
-    float p = 0.0;
-    float t = 0.0;
-    float h = 0.0;
-
-    if (BMX_1_chip_id == BMP280_CHIP_ID) {
-      p = bmp1.readPressure()/100.0F;       // bp1 hPa
-      t = bmp1.readTemperature();           // bt1
-    }
-    else if (BMX_1_chip_id == BME280_BMP390_CHIP_ID) {
-      if (BMX_1_type == BMX_TYPE_BME280) {
-        p = bme1.readPressure()/100.0F;     // bp1 hPa
-        t = bme1.readTemperature();         // bt1
-        h = bme1.readHumidity();            // bh1 
-      }
-      if (BMX_1_type == BMX_TYPE_BMP390) {
-        p = bm31.readPressure()/100.0F;     // bp1 hPa
-        t = bm31.readTemperature();         // bt1 
-      }    
-    }
-    else { // BMP388
-      p = bm31.readPressure()/100.0F;       // bp1 hPa
-      t = bm31.readTemperature();           // bt1
-    }
-    bmx1_pressure = (isnan(p) || (p < QC_MIN_P)  || (p > QC_MAX_P))  ? QC_ERR_P  : p;
-    bmx1_temp     = (isnan(t) || (t < QC_MIN_T)  || (t > QC_MAX_T))  ? QC_ERR_T  : t;
-    bmx1_humid    = (isnan(h) || (h < QC_MIN_RH) || (h > QC_MAX_RH)) ? QC_ERR_RH : h;
-  }
-
-  if (BMX_2_exists) {
-    float p = 0.0;
-    float t = 0.0;
-    float h = 0.0;
-
-    if (BMX_2_chip_id == BMP280_CHIP_ID) {
-      p = bmp2.readPressure()/100.0F;       // bp2 hPa
-      t = bmp2.readTemperature();           // bt2
-    }
-    else if (BMX_2_chip_id == BME280_BMP390_CHIP_ID) {
-      if (BMX_2_type == BMX_TYPE_BME280) {
-        p = bme2.readPressure()/100.0F;     // bp2 hPa
-        t = bme2.readTemperature();         // bt2
-        h = bme2.readHumidity();            // bh2 
-      }
-      if (BMX_2_type == BMX_TYPE_BMP390) {
-        p = bm32.readPressure()/100.0F;     // bp2 hPa
-        t = bm32.readTemperature();         // bt2       
-      }
-    }
-    else { // BMP388
-      p = bm32.readPressure()/100.0F;       // bp2 hPa
-      t = bm32.readTemperature();           // bt2
-    }
-    bmx2_pressure = (isnan(p) || (p < QC_MIN_P)  || (p > QC_MAX_P))  ? QC_ERR_P  : p;
-    bmx2_temp     = (isnan(t) || (t < QC_MIN_T)  || (t > QC_MAX_T))  ? QC_ERR_T  : t;
-    bmx2_humid    = (isnan(h) || (h < QC_MIN_RH) || (h > QC_MAX_RH)) ? QC_ERR_RH : h;
+  RR_Update(OD_Median, true);
+  obs.sg = OD_Median;
+  if (cf_dg_mad) {
+    obs.flags |= OBS_F_SGN;
+    obs.sgn = dg_samples;
   }
-
-  if (HTU21DF_exists) {
-    htu1_humid = htu.readHumidity();
-    htu1_humid = (isnan(htu1_humid) || (htu1_humid < QC_MIN_RH) || (htu1_humid > QC_MAX_RH)) ? QC_ERR_RH : htu1_humid;
-
-    htu1_temp = htu.readTemperature();
-    htu1_temp = (isnan(htu1_temp) || (htu1_temp < QC_MIN_T)  || (htu1_temp > QC_MAX_T))  ? QC_ERR_T  : htu1_temp;
+  if (cf_rr_rate) {
+    obs.flags |= OBS_F_SGRR;
+    obs.sgrr = rr_rate;
   }
-
-  if (SHT_1_exists) {
-    st1 = sht1.readTemperature();
-    st1 = (isnan(st1) || (st1 < QC_MIN_T)  || (st1 > QC_MAX_T))  ? QC_ERR_T  : st1;
-    sh1 = sht1.readHumidity();
-    sh1 = (isnan(sh1) || (sh1 < QC_MIN_RH) || (sh1 > QC_MAX_RH)) ? QC_ERR_RH : sh1;
+  if (cf_dg_stats) {
+    obs.flags |= OBS_F_STATS;
+    obs.sgmn = dg_minimum;
+    obs.sgmx = dg_maximum;
+    obs.sg10 = dg_plo;
+    obs.sg90 = dg_phi;
+    obs.sgmad = dg_mad;
+    obs.sgro = dg_outliers;
   }
 
-  if (SHT_2_exists) {
-    st2 = sht2.readTemperature();
-    st2 = (isnan(st2) || (st2 < QC_MIN_T)  || (st2 > QC_MAX_T))  ? QC_ERR_T  : st2;
-    sh2 = sht2.readHumidity();
-    sh2 = (isnan(sh2) || (sh2 < QC_MIN_RH) || (sh2 > QC_MAX_RH)) ? QC_ERR_RH : sh2;
-  }
-
-  if (HIH8_exists) {
-    bool status = hih8_getTempHumid(&ht2, &hh2);
-    if (!status) {
-      ht2 = -999.99;
-      hh2 = 0.0;
-    }
-    ht2 = (isnan(ht2) || (ht2 < QC_MIN_T)  || (ht2 > QC_MAX_T))  ? QC_ERR_T  : ht2;
-    hh2 = (isnan(hh2) || (hh2 < QC_MIN_RH) || (hh2 > QC_MAX_RH)) ? QC_ERR_RH : hh2;
-  }
-
-  if (SI1145_exists) {
-    si_vis = uv.readVisible();
-    si_ir = uv.readIR();
-    si_uv = uv.readUV()/100.0;
-
-    // Additional code to force sensor online if we are getting 0.0s back.
-    if ( ((si_vis+si_ir+si_uv) == 0.0) && ((si_last_vis+si_last_ir+si_last_uv) != 0.0) ) {
-      // Let Reset The SI1145 and try again
-      Output ("SI RESET");
-      if (uv.begin()) {
-        SI1145_exists = true;
-        Output ("SI ONLINE");
-        SystemStatusBits &= ~SSB_SI1145; // Turn Off Bit
-
-        si_vis = uv.readVisible();
-        si_ir = uv.readIR();
-        si_uv = uv.readUV()/100.0;
-      }
-      else {
-        SI1145_exists = false;
-        Output ("SI OFFLINE");
-        SystemStatusBits |= SSB_SI1145;  // Turn On Bit    
-      }
+  // Adafruit I2C Sensors
+  PERF_Phase(PERF_SENSORS);
+
+  // Read into an aligned array, the FPU can not load floats from the packed record
+  sensors_observe(sv);
+  memcpy(obs.sv, sv, sizeof(obs.sv));
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    if (*sensors[i].exists) {
+      obs.online |= (1 << i);
     }
-
-    // Save current readings for next loop around compare
-    si_last_vis = si_vis;
-    si_last_ir = si_ir;
-    si_last_uv = si_uv;
-
-    // QC Checks
-    si_vis = (isnan(si_vis) || (si_vis < QC_MIN_VI)  || (si_vis > QC_MAX_VI)) ? QC_ERR_VI  : si_vis;
-    si_ir  = (isnan(si_ir)  || (si_ir  < QC_MIN_IR)  || (si_ir  > QC_MAX_IR)) ? QC_ERR_IR  : si_ir;
-    si_uv  = (isnan(si_uv)  || (si_uv  < QC_MIN_UV)  || (si_uv  > QC_MAX_UV)) ? QC_ERR_UV  : si_uv;
-  }
-
-  if (MCP_1_exists) {
-    mcp1_temp = mcp1.readTempC();
-    mcp1_temp = (isnan(mcp1_temp) || (mcp1_temp < QC_MIN_T)  || (mcp1_temp > QC_MAX_T))  ? QC_ERR_T  : mcp1_temp;
-  }
-  if (MCP_2_exists) {
-    mcp2_temp = mcp2.readTempC();
-    mcp2_temp = (isnan(mcp2_temp) || (mcp2_temp < QC_MIN_T)  || (mcp2_temp > QC_MAX_T))  ? QC_ERR_T  : mcp2_temp;
   }
 
-  if (VEML7700_exists) {
-    float lux = veml.readLux(VEML_LUX_AUTO);
-    lux = (isnan(lux) || (lux < QC_MIN_LX)  || (lux > QC_MAX_LX))  ? QC_ERR_LX  : lux;
-  }
-
-  float SignalStrength = 0;
-
 #if PLATFORM_ID == PLATFORM_ARGON
   WiFiSignal sig = WiFi.RSSI();
-  SignalStrength = sig.getStrength();
+  obs.css = sig.getStrength();
 #else
   if (Cellular.ready()) {
     CellularSignal sig = Cellular.RSSI();
-    SignalStrength = sig.getStrength();
+    obs.css = sig.getStrength();
   }
   // Get Battery Charger Failt Register
-  cfr = pmic.getFault();
+  obs.cfr = pmic.getFault();
 
-  BatteryState = System.batteryState();
+  obs.bcs = System.batteryState();
   // Read battery charge information only if battery is connected. 
-  if (BatteryState>0 && BatteryState<6) {
-    BatteryPoC = System.batteryCharge();
+  if (obs.bcs>0 && obs.bcs<6) {
+    obs.bpc = System.batteryCharge();
   }
 #endif
 
+  obs.ts = Time.now();
   stc_timestamp();
   Output(timestamp);
 
   // Report if we have Need to Send Observations
-  if (SD_exists && SD.exists(SD_n2s_file)) {
+  if (SD_exists && eeprom_valid && eeprom.n2s_count) {
     SystemStatusBits |= SSB_N2S; // Turn on Bit
   }
   else {
     SystemStatusBits &= ~SSB_N2S; // Turn Off Bit
   }
+  obs.hth = SystemStatusBits;
 
-  memset(msgbuf, 0, sizeof(msgbuf));
-  JSONBufferWriter writer(msgbuf, sizeof(msgbuf)-1);
-  writer.beginObject();
-    writer.name("at").value(timestamp);
-    writer.name("sg").value(OD_Median);
-
-    if (BMX_1_exists) {
-      writer.name("bp1").value(bmx1_pressure, 4);
-      writer.name("bt1").value(bmx1_temp, 2);
-      writer.name("bh1").value(bmx1_humid, 2);
-    }
-    if (BMX_2_exists) {
-      writer.name("bp2").value(bmx2_pressure, 4);
-      writer.name("bt2").value(bmx2_temp, 2);
-      writer.name("bh2").value(bmx2_humid, 2);
-    }
-    if (HTU21DF_exists) {
-      writer.name("ht1").value(htu1_temp, 2);
-      writer.name("hh1").value(htu1_humid, 2);
-    }
-    if (MCP_1_exists) {
-      writer.name("mt1").value(mcp1_temp, 2);
-    }
-    if (MCP_2_exists) {
-      writer.name("mt2").value(mcp2_temp, 2);
-    }
-    if (SHT_1_exists) {
-      writer.name("st1").value(st1, 2);
-      writer.name("sh1").value(sh1, 2);
-    }
-    if (SHT_2_exists) {
-      writer.name("st2").value(st2, 2);
-      writer.name("sh2").value(sh2, 2);
-    }
-    if (HIH8_exists) {
-      writer.name("ht2").value(ht2, 2);
-      writer.name("hh2").value(hh2, 2);
-    }
-    if (SI1145_exists) {
-      writer.name("sv1").value(si_vis, 2);
-      writer.name("si1").value(si_ir, 2);
-      writer.name("su1").value(si_uv, 2);
-    }
-    if (VEML7700_exists) {
-      writer.name("lx").value(lux, 2);
-    }
-
-    writer.name("bcs").value(BatteryState);
-    writer.name("bpc").value(BatteryPoC, 4);
-    writer.name("cfr").value(cfr);
-    writer.name("css").value(SignalStrength, 4);
-    writer.name("hth").value(SystemStatusBits);
-  writer.endObject();
+  OBS_JSON(&obs, true);
 
   // Log Observation to SD Card
-  SD_LogObservation(msgbuf);
+  PERF_Phase(PERF_SDLOG);
+  if (cf_sd_log != 1) {
+    SD_LogObservation(msgbuf);
+  }
+  if (cf_sd_log) {
+    len = OBS_N2SEncode(&obs, rec);
+    SD_LogRecord(rec, len);
+  }
   Serial_write (msgbuf);
 
   lastOBS = System.millis();
 
+  // Compact observation, the SD log keeps the JSON
+  if (cf_sg_compact) {
+    OBS_Compact(&obs);
+  }
+
   Output ("Publish(SG)");
-  if (Particle_Publish((char *) "SG")) {
+  PERF_Phase(PERF_PUBLISH);
+  if (Particle_Publish((char *) (cf_sg_compact ? "SGC" : "SG"))) {
     PostedResults = true;
 
     if (SD_exists) {
@@ -312,6 +596,7 @@ void OBS_Do() {
     }
 
     // If we Published, Lets try send N2S observations
+    PERF_Phase(PERF_N2S);
     SD_N2S_Publish();
   }
   else {
@@ -321,85 +606,13 @@ void OBS_Do() {
     
     // Set the bit so when we finally transmit the observation,
     // we know it cam from the N2S file.
-    SystemStatusBits |= SSB_FROM_N2S; // Turn On Bit
-
-    memset(msgbuf, 0, sizeof(msgbuf));
-    // SEE https://docs.particle.io/reference/device-os/firmware/argon/#jsonwriter
-    JSONBufferWriter writer(msgbuf, sizeof(msgbuf)-1);
-    writer.beginObject();
-      writer.name("at").value(timestamp);
-      writer.name("sg").value(OD_Median);
-
-      if (BMX_1_exists) {
-        // sprintf (Buffer32Bytes, "%d.%02d", (int)bmx1_pressure, (int)(bmx1_pressure*100)%100);
-        // writer.name("bp1").value(Buffer32Bytes);
-        writer.name("bp1").value(bmx1_pressure, 4);
-        writer.name("bt1").value(bmx1_temp, 4);
-        if (BMX_1_type == BMX_TYPE_BME280) {
-          writer.name("bh1").value(bmx1_humid, 4);
-        }
-      }
-      if (BMX_2_exists) {
-        // sprintf (Buffer32Bytes, "%d.%02d", (int)bmx2_pressure, (int)(bmx2_pressure*100)%100);
-        // writer.name("bp2").value(Buffer32Bytes);
-        writer.name("bp2").value(bmx2_pressure, 4);
-        writer.name("bt2").value(bmx2_temp, 4);
-        if (BMX_2_type == BMX_TYPE_BME280) {
-          writer.name("bh2").value(bmx2_humid, 4);
-        }
-      }
-      if (HTU21DF_exists) {
-        writer.name("ht1").value(htu1_temp, 2);
-        writer.name("hh1").value(htu1_humid, 2);
-      }
-      if (MCP_1_exists) {
-        writer.name("mt1").value(mcp1_temp, 2);
-      }
-      if (MCP_2_exists) {
-        writer.name("mt2").value(mcp2_temp, 2);
-      }
-      if (SHT_1_exists) {
-        writer.name("st1").value(st1, 2);
-        writer.name("sh1").value(sh1, 2);
-      }
-      if (SHT_2_exists) {
-        writer.name("st2").value(st2, 2);
-        writer.name("sh2").value(sh2, 2);
-      }
-      if (HIH8_exists) {
-        writer.name("ht2").value(ht2, 2);
-        writer.name("hh2").value(hh2, 2);
-      }
-      if (SI1145_exists) {
-        writer.name("sv1").value(si_vis, 2);
-        writer.name("si1").value(si_ir, 2);
-        writer.name("su1").value(si_uv, 2);
-      }
-      if (VEML7700_exists) {
-        writer.name("lx").value(lux, 2);
-      } 
-      writer.name("bcs").value(BatteryState);
-      writer.name("bpc").value(BatteryPoC, 4);
-      writer.name("cfr").value(cfr);
-      writer.name("css").value(SignalStrength, 4);
-      writer.name("hth").value(SystemStatusBits);
-    writer.endObject();
-    SystemStatusBits &= ~SSB_FROM_N2S; // Turn Off Bit
+    obs.hth |= SSB_FROM_N2S;
+    len = OBS_N2SEncode(&obs, rec);
 
-    SD_NeedToSend_Add(msgbuf);
+    PERF_Phase(PERF_SDLOG);
+    SD_NeedToSend_Add(rec, len);
   }
 
   Output(timestamp);
-
-  sprintf (msgbuf, "%d %d.%02d %d.%02d", OD_Median,
-    (int)bmx1_pressure, (int)(bmx1_pressure*100)%100,
-    (int)bmx2_pressure, (int)(bmx2_pressure*100)%100);
-  Output(msgbuf);
-
-  sprintf (msgbuf, "C%d.%02d B%d:%d.%02d %04X", 
-    (int)SignalStrength, (int)(SignalStrength*100)%100,
-    BatteryState, 
-    (int)BatteryPoC, (int)(BatteryPoC*100)%100,
-    SystemStatusBits);
-  Output(msgbuf);
+  OBS_Display(&obs);
 }
\ No newline at end of file
@@ -0,0 +1,328 @@
+/*
+ * ======================================================================================================================
+ *  PERF.h - Awake Time and Energy Accounting
+ * ======================================================================================================================
+ */
+
+/*
+ * ======================================================================================================================
+ *  Awake Cycle Timing
+ *
+ *  Our battery budget is spent while we are awake between ULTRA_LOW_POWER sleeps. The time from boot or wake up
+ *  to entering sleep is measured with System.millis() and reported before we go to sleep. If the awake time is
+ *  over cf_awake_budget seconds the SSB_AWAKE bit is set and reported with the next observation.
+ *
+ *  The awake time is split into phases with PERF_Phase() markers. Time is also split by modem state so we can
+ *  estimate the mAh used with the per state current draws from CONFIG.TXT (ma_awake, ma_modem, ma_sleep).
+ *
+ *  Distance burst wakes (cf_dg_burst) come after the cycle has been reported, inside its sleep. PERF_BurstEnd()
+ *  moves each one from the sleep time of the last cycle to its awake time, in the "dgb" phase.
+ *
+ *  cf_perf controls reporting
+ *    0 = Off
+ *    1 = Add a "perf" object with the last completed cycle to the SG observation
+ *    2 = Publish a daily PERF event with the totals for the previous day
+ *    3 = Both
+ * ======================================================================================================================
+ */
+// Prototyping functions to aviod compile function unknown issue.
+bool Particle_Publish(char *EventName);
+
+#define PERF_BOOT            0    // Boot or wake up overhead
+#define PERF_DISCOVERY       1    // I2C sensor discovery and online checks
+#define PERF_RTC             2    // RTC initialize and updates
+#define PERF_CONNECT         3    // Waiting on the network connection
+#define PERF_DISTANCE        4    // Distance gauge sampling
+#define PERF_SENSORS         5    // I2C sensor reads
+#define PERF_SDLOG           6    // Logging observations to the SD card
+#define PERF_PUBLISH         7    // Publishing observation and INFO
+#define PERF_N2S             8    // Publishing Need to Send observations
+#define PERF_SLEEP           9    // Sleep entry, modem and display off
+#define PERF_BURST          10    // Distance burst wakes during the sleep
+#define PERF_PHASES         11
+#define PERF_MAGIC          0x50524633  // "PRF3" - Retained memory is valid, changed with the PERF_STATS layout
+
+const char *perf_phase_key[PERF_PHASES] = {"boot", "disc", "rtc", "conn", "dist", "sens", "sdl", "pub", "n2s",
+                                           "slpe", "dgb"};
+
+typedef struct {
+  uint32_t cycles;                    // Completed cycles
+  uint32_t phase_ms[PERF_PHASES];     // Milliseconds in each phase
+  uint32_t mcu_ms;                    // Milliseconds awake with the modem off
+  uint32_t modem_ms;                  // Milliseconds awake with the modem on
+  uint32_t sleep_ms;                  // Milliseconds in ULTRA_LOW_POWER sleep
+  uint32_t sleep_modem_ms;            // Milliseconds in ULTRA_LOW_POWER sleep with the modem left on, rapid reporting
+  uint32_t pub_count;                 // Particle publishes
+  uint32_t pub_bytes;                 // Bytes published, event names and data
+  uint32_t sd_bytes;                  // Bytes written to the SD card
+} PERF_STATS;
+
+typedef struct {
+  uint32_t magic;                     // PERF_MAGIC when the below is valid
+  int day;                            // Day of month the today totals are for
+  bool yesterday_ready;               // Daily PERF event waiting to be published
+  time32_t yesterday_ts;              // Time the yesterday totals were closed
+  PERF_STATS today;
+  PERF_STATS yesterday;
+} PERF_RETAINED;
+
+retained PERF_RETAINED perf_retained; // Daily totals survive sleep and a reset
+PERF_STATS perf_cycle;                // Cycle in progress
+PERF_STATS perf_last;                 // Last completed cycle
+
+uint64_t perf_awake_start = 0;        // System.millis() at boot or wake up
+uint64_t perf_mark = 0;               // System.millis() at the last phase or modem change
+uint32_t perf_awake_last = 0;         // Milliseconds awake in the last completed cycle
+uint32_t perf_cycles = 0;             // Number of completed wake, observe, publish, sleep cycles since boot
+int perf_phase = PERF_BOOT;           // Phase we are accounting time to
+bool perf_modem_on = false;           // Modem state we are accounting time to
+bool perf_last_today = false;         // perf_last was added to the today totals
+uint64_t perf_burst_start = 0;        // System.millis() at a burst wake
+
+/*
+ *=======================================================================================================================
+ * PERF_Account() - Add the time since the last mark to the current phase and modem state
+ *=======================================================================================================================
+ */
+void PERF_Account() {
+  uint64_t ms = System.millis();
+  uint32_t dt = (uint32_t) (ms - perf_mark);
+
+  perf_cycle.phase_ms[perf_phase] += dt;
+  if (perf_modem_on) {
+    perf_cycle.modem_ms += dt;
+  }
+  else {
+    perf_cycle.mcu_ms += dt;
+  }
+  perf_mark = ms;
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_Phase() - Start accounting time to a new phase
+ *=======================================================================================================================
+ */
+void PERF_Phase(int phase) {
+  PERF_Account();
+  perf_phase = phase;
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_Modem() - Modem has been turned on or off
+ *=======================================================================================================================
+ */
+void PERF_Modem(bool on) {
+  PERF_Account();
+  perf_modem_on = on;
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_mAh() - Estimate mAh used from the per state current draws
+ *=======================================================================================================================
+ */
+float PERF_mAh(PERF_STATS *ps) {
+  return ((ps->mcu_ms * cf_ma_awake) + ((ps->modem_ms + ps->sleep_modem_ms) * cf_ma_modem) + 
+          (ps->sleep_ms * cf_ma_sleep)) / 3600000.0;
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_CycleStart() - Called at boot and on wake up to start timing the awake part of the cycle
+ *=======================================================================================================================
+ */
+void PERF_CycleStart() {
+  if (perf_retained.magic != PERF_MAGIC) {
+    memset(&perf_retained, 0, sizeof(perf_retained));
+    perf_retained.magic = PERF_MAGIC;
+  }
+  memset(&perf_cycle, 0, sizeof(perf_cycle));
+  perf_awake_start = System.millis();
+  perf_mark = perf_awake_start;
+  perf_phase = PERF_BOOT;
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_Published() - Count a successful publish
+ *=======================================================================================================================
+ */
+void PERF_Published(const char *EventName, const char *data) {
+  perf_cycle.pub_count++;
+  perf_cycle.pub_bytes += strlen(EventName) + strlen(data);
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_SDWrite() - Count bytes written to the SD card
+ *=======================================================================================================================
+ */
+void PERF_SDWrite(uint32_t bytes) {
+  perf_cycle.sd_bytes += bytes;
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_Add() - Add cycle stats to a total
+ *=======================================================================================================================
+ */
+void PERF_Add(PERF_STATS *total, PERF_STATS *ps) {
+  total->cycles += ps->cycles;
+  for (int i=0; i<PERF_PHASES; i++) {
+    total->phase_ms[i] += ps->phase_ms[i];
+  }
+  total->mcu_ms += ps->mcu_ms;
+  total->modem_ms += ps->modem_ms;
+  total->sleep_ms += ps->sleep_ms;
+  total->sleep_modem_ms += ps->sleep_modem_ms;
+  total->pub_count += ps->pub_count;
+  total->pub_bytes += ps->pub_bytes;
+  total->sd_bytes += ps->sd_bytes;
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_CycleEnd() - Called just before we go to sleep for sleep_ms, report how long we have been awake
+ *=======================================================================================================================
+ */
+void PERF_CycleEnd(uint32_t sleep_ms) {
+  PERF_Account();
+  perf_awake_last = (uint32_t) (System.millis() - perf_awake_start);
+  perf_cycles++;
+
+  perf_cycle.cycles = 1;
+  if (perf_modem_on) {
+    perf_cycle.sleep_modem_ms = sleep_ms;
+  }
+  else {
+    perf_cycle.sleep_ms = sleep_ms;
+  }
+  perf_last = perf_cycle;
+
+  // Close out the day's totals, they are published with the next connected cycle
+  if (Time.isValid()) {
+    if (perf_retained.day != Time.day()) {
+      if (perf_retained.day && perf_retained.today.cycles) {
+        perf_retained.yesterday = perf_retained.today;
+        perf_retained.yesterday_ts = Time.now();
+        perf_retained.yesterday_ready = true;
+      }
+      memset(&perf_retained.today, 0, sizeof(perf_retained.today));
+      perf_retained.day = Time.day();
+    }
+    PERF_Add(&perf_retained.today, &perf_cycle);
+  }
+  perf_last_today = Time.isValid();
+
+  sprintf (Buffer32Bytes, "AWAKE[%lu]:%lums", perf_cycles, perf_awake_last);
+  Output (Buffer32Bytes);
+
+  // Three 10 digit counts do not fit Buffer32Bytes
+  char buf[48];
+  FMT_BUF f;
+  fmt_begin(&f, buf, sizeof(buf));
+  fmt_str(&f, "P:");
+  fmt_uint(&f, perf_cycle.pub_count);
+  fmt_char(&f, ',');
+  fmt_uint(&f, perf_cycle.pub_bytes);
+  fmt_str(&f, "B SD:");
+  fmt_uint(&f, perf_cycle.sd_bytes);
+  fmt_char(&f, 'B');
+  Output (buf);
+
+  if (cf_awake_budget && (perf_awake_last > (uint32_t) cf_awake_budget * 1000)) {
+    Output ("AWAKE:OVER BUDGET");
+    SystemStatusBits |= SSB_AWAKE;  // Turn On Bit - Note this will be reported on next observation
+  }
+  else {
+    SystemStatusBits &= ~SSB_AWAKE; // Turn Off Bit
+  }
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_BurstStart() - Called on a burst wake from the sleep after PERF_CycleEnd()
+ *=======================================================================================================================
+ */
+void PERF_BurstStart() {
+  perf_burst_start = System.millis();
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_BurstMove() - Move ms of a cycle's sleep to awake time in the burst phase
+ *=======================================================================================================================
+ */
+void PERF_BurstMove(PERF_STATS *ps, uint32_t ms) {
+  ps->phase_ms[PERF_BURST] += ms;
+  ps->mcu_ms += ms;
+  ps->sleep_ms -= min(ps->sleep_ms, ms);
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_BurstEnd() - Called going back to sleep after a burst, charge the time awake to the last cycle
+ *=======================================================================================================================
+ */
+void PERF_BurstEnd() {
+  uint32_t ms = (uint32_t) (System.millis() - perf_burst_start);
+
+  PERF_BurstMove(&perf_last, ms);
+  if (perf_last_today) {
+    PERF_BurstMove(&perf_retained.today, ms);
+  }
+  perf_awake_last += ms;
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_JSON() - Add perf stats to a json object being built
+ *=======================================================================================================================
+ */
+void PERF_JSON(FMT_BUF *f, PERF_STATS *ps) {
+  fmt_json_uint(f, "cyc", ps->cycles);
+  fmt_json_uint(f, "awk", ps->mcu_ms + ps->modem_ms);
+  for (int i=0; i<PERF_PHASES; i++) {
+    fmt_json_uint(f, perf_phase_key[i], ps->phase_ms[i]);
+  }
+  fmt_json_uint(f, "mdm", ps->modem_ms);
+  fmt_json_uint(f, "slp", ps->sleep_ms);
+  fmt_json_uint(f, "slpm", ps->sleep_modem_ms);
+  fmt_json_uint(f, "pubn", ps->pub_count);
+  fmt_json_uint(f, "pubb", ps->pub_bytes);
+  fmt_json_uint(f, "sdb", ps->sd_bytes);
+  fmt_json_float(f, "mah", PERF_mAh(ps), 4);
+}
+
+/*
+ *=======================================================================================================================
+ * PERF_Publish() - Publish the totals for the previous day as a PERF event
+ *=======================================================================================================================
+ */
+void PERF_Publish() {
+  FMT_BUF f;
+
+  if (!(cf_perf & 2) || !perf_retained.yesterday_ready) {
+    return;
+  }
+
+  fmt_begin(&f, msgbuf, sizeof(msgbuf));
+  fmt_char(&f, '{');
+    fmt_json_key(&f, "at");
+    fmt_char(&f, '"');
+    fmt_timestamp(&f, perf_retained.yesterday_ts);
+    fmt_char(&f, '"');
+    PERF_JSON(&f, &perf_retained.yesterday);
+  fmt_char(&f, '}');
+
+  if (Particle_Publish((char *) "PERF")) {
+    perf_retained.yesterday_ready = false;
+    Serial_write (msgbuf);
+    Output ("PERF->PUB OK");
+  }
+  else {
+    Output ("PERF->PUB ERR"); // Try again next cycle
+  }
+}
@@ -10,12 +10,15 @@
  * ======================================================================================================================
  */
 void Output_CellBatteryInfo() {
+  FMT_BUF f;
+
+  fmt_begin(&f, Buffer32Bytes, sizeof(Buffer32Bytes));
 #if PLATFORM_ID == PLATFORM_ARGON
   WiFiSignal sig = WiFi.RSSI();
   float SignalStrength = sig.getStrength();
 
-  sprintf (Buffer32Bytes, "CS:%d.%02d", 
-    (int)SignalStrength, (int)(SignalStrength*100)%100);
+  fmt_str(&f, "CS:");
+  fmt_float(&f, SignalStrength, 2);
   Output(Buffer32Bytes);
 #else
   CellularSignal sig = Cellular.RSSI();
@@ -29,9 +32,12 @@ void Output_CellBatteryInfo() {
     BatteryPoC = System.batteryCharge();
   }
   
-  sprintf (Buffer32Bytes, "CS:%d.%02d B:%d,%d.%02d", 
-    (int)SignalStrength, (int)(SignalStrength*100)%100,
-    BatteryState, (int)BatteryPoC, (int)(BatteryPoC*100)%100);
+  fmt_str(&f, "CS:");
+  fmt_float(&f, SignalStrength, 2);
+  fmt_str(&f, " B:");
+  fmt_int(&f, BatteryState);
+  fmt_char(&f, ',');
+  fmt_float(&f, BatteryPoC, 2);
   Output(Buffer32Bytes);
 #endif
 }
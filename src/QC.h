@@ -44,3 +44,32 @@
 #define QC_MIN_WD      0         // deg
 #define QC_MAX_WD      360       // deg
 #define QC_ERR_WD      -999      // deg Error
+
+/*
+ * ======================================================================================================================
+ *  QC Ranges - Indexed by the kind of value, used by the sensor descriptor table
+ * ======================================================================================================================
+ */
+#define QC_T           0         // Temperature
+#define QC_P           1         // Pressure
+#define QC_RH          2         // Relative Humidity
+#define QC_IR          3         // SI1145 Infrared
+#define QC_VI          4         // SI1145 Visible
+#define QC_UV          5         // SI1145 UV
+#define QC_LX          6         // VEML7700 Lux
+
+typedef struct {
+  float min;
+  float max;
+  float err;
+} QC_RANGE;
+
+const QC_RANGE qc_range[] = {
+  {QC_MIN_T,  QC_MAX_T,  QC_ERR_T},
+  {QC_MIN_P,  QC_MAX_P,  QC_ERR_P},
+  {QC_MIN_RH, QC_MAX_RH, QC_ERR_RH},
+  {QC_MIN_IR, QC_MAX_IR, QC_ERR_IR},
+  {QC_MIN_VI, QC_MAX_VI, QC_ERR_VI},
+  {QC_MIN_UV, QC_MAX_UV, QC_ERR_UV},
+  {QC_MIN_LX, QC_MAX_LX, QC_ERR_LX},
+};
@@ -8,10 +8,18 @@
 #define KEY_MAX_LENGTH    30                // Config File Key Length
 #define VALUE_MAX_LENGTH  30                // Config File Value Length
 #define LINE_MAX_LENGTH   VALUE_MAX_LENGTH+KEY_MAX_LENGTH+3   // =, CR, LF 
+#define N2S_HDR           2                 // Schema and length bytes that start each N2S record
+#define N2S_REC_MAX       255               // Largest N2S record, the length is one byte
+#define OBS_LINE_MAX      448               // Largest positional line of an N2S record in an SGB event
+#define LOG_HDR_BUF       512               // Largest binary daily log header, see OBS_LogHeader()
 
 // Prototyping functions to aviod compile function unknown issue.
 bool Particle_Publish(char *EventName); 
 void OBS_Do();
+bool OBS_N2SValid(uint8_t *rec, int len);
+bool OBS_N2S_JSON(uint8_t *rec, int len);
+int OBS_N2S_Append(uint8_t *rec, int len, int max, uint32_t *ts_prev);
+int OBS_LogHeader(uint8_t *hdr);
 
 /* 
  *=======================================================================================================================
@@ -69,6 +77,7 @@ void SD_LogObservation(char *observations) {
   if (fp) {
     fp.println(observations);
     fp.close();
+    PERF_SDWrite(strlen(observations)+2);
     SystemStatusBits &= ~SSB_SD;  // Turn Off Bit
     Output ("OBS Logged to SD");
   }
@@ -82,69 +91,388 @@ void SD_LogObservation(char *observations) {
 
 /* 
  *=======================================================================================================================
- * SD_N2S_Delete()
+ * SD_LogRecord() - Append a binary observation record and its CRC to the daily .bin log, header first in a new file
  *=======================================================================================================================
  */
-bool SD_N2S_Delete() {
-  bool result;
-
-  if (SD_exists && SD.exists(SD_n2s_file)) {
-    if (SD.remove (SD_n2s_file)) {
-      SystemStatusBits &= ~SSB_N2S; // Turn Off Bit
-      Output ("N2S->DEL:OK");
-      result = true;
-    }
-    else {
-      Output ("N2S->DEL:ERR");
-      SystemStatusBits |= SSB_SD; // Turn On Bit
-      result = false;
+void SD_LogRecord(uint8_t *rec, int len) {
+  char SD_logfile[24];
+  uint8_t buf[N2S_REC_MAX + 2];
+  uint16_t crc;
+  File fp;
+
+  if (!SD_exists || !Time.isValid()) {
+    return;
+  }
+
+  sprintf (SD_logfile, "%s/%4d%02d%02d.bin", SD_obsdir, Time.year(), Time.month(), Time.day());
+
+  fp = SD.open(SD_logfile, FILE_WRITE); 
+  if (fp) {
+    if (fp.size() == 0) {
+      uint8_t hdr[LOG_HDR_BUF];
+      int n = OBS_LogHeader(hdr);
+      fp.write(hdr, n);
+      PERF_SDWrite(n);
     }
+    crc = crc16(rec, len);
+    memcpy(buf, rec, len);
+    memcpy(&buf[len], &crc, 2);
+    fp.write(buf, len + 2);      // One write so a brown out tears at most the last record
+    fp.close();
+    PERF_SDWrite(len + 2);
+    SystemStatusBits &= ~SSB_SD;  // Turn Off Bit
+    Output ("OBS Logged to SD(bin)");
   }
   else {
-    Output ("N2S->DEL:NF");
-    result = true;
+    SystemStatusBits |= SSB_SD;  // Turn On Bit - Note this will be reported on next observation
+    Output ("OBS Open Bin Err");
   }
-  eeprom.n2sfp = 0;
+}
+
+/*
+ * ======================================================================================================================
+ *  Need to Send Ring
+ *
+ *  SD_n2s_file is created once with SD_n2s_max_filesz bytes of contiguous clusters and is never grown or deleted,
+ *  so adding a record is a seek and a write with no FAT updates. Records are written at the head and sent from the
+ *  tail. A record never splits across the end of the ring, a 0 schema byte marks where the head went back to the
+ *  start. The head, tail and record count are checkpointed in EEPROM_NVM. When a record does not fit the oldest
+ *  records are dropped, so the backlog always holds the most recent observations.
+ * ======================================================================================================================
+ */
+
+/* 
+ *=======================================================================================================================
+ * SD_N2S_Reset() - Empty the ring, the preallocated file is kept
+ *=======================================================================================================================
+ */
+void SD_N2S_Reset() {
+  eeprom.n2s_head = 0;
+  eeprom.n2s_tail = 0;
+  eeprom.n2s_count = 0;
   EEPROM_Update();
-  return (result);
+  SystemStatusBits &= ~SSB_N2S; // Turn Off Bit
+  Output ("N2S->RESET");
 }
 
 /* 
  *=======================================================================================================================
- * SD_NeedToSend_Add()
+ * SD_N2S_Open() - Open the ring for reading and writing, create it if missing or the wrong size
  *=======================================================================================================================
  */
-void SD_NeedToSend_Add(char *observation) {
+bool SD_N2S_Open(File &fp) {
+  if (!SD_exists) {
+    return (false);
+  }
+
+  if (!eeprom_valid) {
+    EEPROM_Initialize(); // Head and tail are useless if we can not checkpoint them
+    if (!eeprom_valid) {
+      Output ("N2S:EEPROM ERR");
+      return (false);
+    }
+  }
+
+  fp = SD.open(SD_n2s_file, O_RDWR);
+  if (fp) {
+    if (fp.size() == SD_n2s_max_filesz) {
+      if ((eeprom.n2s_head > SD_n2s_max_filesz) || (eeprom.n2s_tail > SD_n2s_max_filesz)) {
+        Output ("N2S:Bad Offsets");
+        SD_N2S_Reset();
+      }
+      return (true);
+    }
+    fp.close();
+    SD.remove (SD_n2s_file); // Old style or resized file
+  }
+
+  SD_N2S_Reset();
+  if (fp.createContiguous(SD_n2s_file, SD_n2s_max_filesz)) {
+    Output ("N2S:Created");
+    return (true);
+  }
+  SystemStatusBits |= SSB_SD;  // Turn On Bit - Note this will be reported on next observation
+  Output ("N2S:Create Error");
+  return (false);
+}
+
+/* 
+ *=======================================================================================================================
+ * SD_N2S_Read() - Read the record at pos into rec and move pos past it, return its length or -1 on bad data
+ *=======================================================================================================================
+ */
+int SD_N2S_Read(File &fp, uint32_t *pos, uint8_t *rec) {
+  int len;
+
+  for (int i=0; i<2; i++) {
+    if (*pos + N2S_HDR > SD_n2s_max_filesz) {
+      *pos = 0;  // No room for a record at the end
+      continue;
+    }
+    if (!fp.seek(*pos) || (fp.read(rec, N2S_HDR) != N2S_HDR)) {
+      return (-1);
+    }
+    if (rec[0] == 0) {
+      *pos = 0;  // Wrap marker
+      continue;
+    }
+    len = rec[1];
+    if ((len <= N2S_HDR) || (*pos + len > SD_n2s_max_filesz) || (fp.read(rec+N2S_HDR, len-N2S_HDR) != len-N2S_HDR)) {
+      return (-1);
+    }
+    *pos += len;
+    return (len);
+  }
+  return (-1); // Wrap marker at the start of the ring
+}
+
+/* 
+ *=======================================================================================================================
+ * SD_N2S_Skip() - Move pos past a bad record to the next good one, return the records from there to the head
+ * 
+ *  Records have no sync marker, so each offset after pos is tried in turn. An offset is taken when every record
+ *  from it decodes and the last one ends at the head. 0 is returned, with pos at the head, when none is found.
+ *=======================================================================================================================
+ */
+uint32_t SD_N2S_Skip(File &fp, uint32_t *pos) {
+  uint8_t rec[N2S_REC_MAX];
+  uint32_t p = *pos;
+  uint32_t next, count;
+  int len;
+
+  for (uint32_t i=0; i<SD_n2s_max_filesz; i++) {
+    if (++p >= SD_n2s_max_filesz) {
+      p = 0;
+    }
+    if (p == eeprom.n2s_head) {
+      break;
+    }
+
+    // Walk the records from p, at most as many as the ring claimed to hold
+    for (next = p, count = 0; (next != eeprom.n2s_head) && (count <= eeprom.n2s_count); count++) {
+      if (((len = SD_N2S_Read(fp, &next, rec)) < 0) || !OBS_N2SValid(rec, len)) {
+        break;
+      }
+    }
+    if ((next == eeprom.n2s_head) && count && (count <= eeprom.n2s_count)) {
+      *pos = p;
+      return (count);
+    }
+  }
+  *pos = eeprom.n2s_head;
+  return (0);
+}
+
+/* 
+ *=======================================================================================================================
+ * SD_NeedToSend_Add() - Write a record at the head of the ring, dropping the oldest records to make room
+ *=======================================================================================================================
+ */
+void SD_NeedToSend_Add(uint8_t *rec, int len) {
+  uint8_t old[N2S_REC_MAX];
+  uint8_t wrap = 0;
+  uint32_t pos;
+  int dropped = 0;
   File fp;
 
-  if (!SD_exists) {
+  if (!SD_N2S_Open(fp)) {
+    Output ("N2S:Open Error");
     return;
   }
-  
-  fp = SD.open(SD_n2s_file, FILE_WRITE); // Open the file for reading and writing, starting at the end of the file.
-                                         // It will be created if it doesn't already exist.
-  if (fp) {  
-    if (fp.size() > SD_n2s_max_filesz) {
-      fp.close();
-      Output ("N2S:Full");
-      if (SD_N2S_Delete()) {
-        // Only call ourself again if we truely deleted the file. Otherwise infinate loop.
-        SD_NeedToSend_Add(observation); // Now go and log the data
+
+  for (;;) {
+    if (eeprom.n2s_count == 0) {
+      eeprom.n2s_tail = eeprom.n2s_head;  // Empty, carry on from where we are
+    }
+
+    if (eeprom.n2s_count && (eeprom.n2s_tail >= eeprom.n2s_head)) {
+      // Wrapped, the free space runs from the head up to the oldest record
+      if (eeprom.n2s_head + len <= eeprom.n2s_tail) {
+        pos = eeprom.n2s_head;
+        break;
       }
     }
-    else {
-      fp.println(observation); //Print data, followed by a carriage return and newline, to the File
-      fp.close();
-      SystemStatusBits &= ~SSB_SD;  // Turn Off Bit
-      Output ("N2S:OBS Added");
+    else if (eeprom.n2s_head + len <= SD_n2s_max_filesz) {
+      pos = eeprom.n2s_head;
+      break;
+    }
+    else if ((eeprom.n2s_count == 0) || (eeprom.n2s_tail >= (uint32_t) len)) {
+      // No room at the end, mark it and go back to the start
+      if (eeprom.n2s_head < SD_n2s_max_filesz) {
+        fp.seek(eeprom.n2s_head);
+        fp.write(&wrap, 1);
+      }
+      if (eeprom.n2s_count == 0) {
+        eeprom.n2s_tail = 0;
+      }
+      pos = 0;
+      break;
+    }
+
+    // Full, drop the oldest record. A tail at the wrap marker or the end of the file has no record left to drop
+    // before the start, the ring is no longer wrapped and there may be room after the head.
+    pos = eeprom.n2s_tail;
+    if ((eeprom.n2s_tail >= eeprom.n2s_head) && ((pos + N2S_HDR > SD_n2s_max_filesz) ||
+        (fp.seek(pos) && (fp.read(old, 1) == 1) && (old[0] == 0)))) {
+      eeprom.n2s_tail = 0;
+      continue;
     }
+    if (SD_N2S_Read(fp, &pos, old) < 0) {
+      Output ("N2S:Bad Record");
+      pos = eeprom.n2s_tail;
+      eeprom.n2s_count = SD_N2S_Skip(fp, &pos);
+      eeprom.n2s_tail = pos;
+      if (eeprom.n2s_count == 0) {
+        eeprom.n2s_head = 0;
+      }
+      dropped++;
+      continue;
+    }
+    eeprom.n2s_tail = pos;
+    eeprom.n2s_count--;
+    dropped++;
+  }
+
+  if (dropped) {
+    // Checkpoint the new tail before its old records are overwritten
+    EEPROM_Update();
+    sprintf (Buffer32Bytes, "N2S:Full Drop %d", dropped);
+    Output (Buffer32Bytes);
+  }
+
+  if (fp.seek(pos) && (fp.write(rec, len) == (size_t) len)) { // Binary N2S record, see OBS_N2SEncode()
+    fp.close();
+    PERF_SDWrite(len);
+    eeprom.n2s_head = pos + len;
+    eeprom.n2s_count++;
+    EEPROM_Update();
+    SystemStatusBits &= ~SSB_SD;  // Turn Off Bit
+    SystemStatusBits |= SSB_N2S;  // Turn On Bit
+    Output ("N2S:OBS Added");
   }
   else {
+    fp.close();
     SystemStatusBits |= SSB_SD;  // Turn On Bit - Note this will be reported on next observation
-    Output ("N2S:Open Error");
-    // At thins point we could set SD_exists to false and/or set a status bit to report it
-    // sd_initialize();  // Reports SD NOT Found. Library bug with SD
+    Output ("N2S:Write Error");
+  }
+}
+
+/* 
+ *=======================================================================================================================
+ * SD_N2S_Batch() - Fill msgbuf with the next N2S event, return the records in it, 0 when count are done, -1 on bad data
+ * 
+ *  With cf_n2s_batch an SGB event holds as many records as fit in the event data, one SG event per record without.
+ *  pos is moved past the records in the event. A bad record ends the event before it, -1 is returned only when
+ *  the record at pos is bad.
+ *=======================================================================================================================
+ */
+int SD_N2S_Batch(File &fp, uint32_t *pos, uint32_t count) {
+  uint8_t rec[N2S_REC_MAX];
+  uint32_t ts_prev = 0;
+  uint32_t next;
+  int max = min((int) Particle.maxEventDataSize(), MAX_MSGBUF_SIZE-1);
+  int len, r;
+  int n = 0;
+
+  memset(msgbuf, 0, sizeof(msgbuf));
+  while ((uint32_t) n < count) {
+    // Record is schema, length then the rest of the record. OBS_N2S_JSON() and OBS_N2S_Append() validate it.
+    next = *pos;
+    if ((len = SD_N2S_Read(fp, &next, rec)) < 0) {
+      break;
+    }
+
+    if (!cf_n2s_batch) {
+      if (!OBS_N2S_JSON(rec, len)) {
+        return (-1);
+      }
+      *pos = next;
+      return (1);
+    }
+
+    r = OBS_N2S_Append(rec, len, max, &ts_prev);
+    if (r <= 0) {
+      break;  // Event is full or the record is bad, it starts the next one
+    }
+    *pos = next;
+    n++;
+  }
+  if ((n == 0) && count) {
+    return (-1);
   }
+  return (n);
+}
+
+/* 
+ *=======================================================================================================================
+ * SD_N2S_Legacy() - Publish the JSON line backlog older firmware left in N2SOBS.TXT as SG events, then remove it
+ * 
+ *  The EEPROM layout changed with the ring and the old file offset went with it, so the file is sent from the
+ *  start and a few lines may be published twice. SD_n2s_legacy_pos is retained so a failed publish picks up at
+ *  the same line next time. Returns true when there is no backlog left.
+ *=======================================================================================================================
+ */
+bool SD_N2S_Legacy() {
+  File fp;
+  char ch;
+  int i = 0;
+  int sent = 0;
+  int bad = 0;
+  bool toolong = false;
+
+  if (!SD_exists || !SD.exists(SD_n2s_legacy_file)) {
+    return (true);
+  }
+  fp = SD.open(SD_n2s_legacy_file, FILE_READ);
+  if (!fp) {
+    return (true);
+  }
+  Output ("N2S:Legacy");
+
+  // Retained memory is not cleared on power up, only trust an offset at the start of a line
+  if ((SD_n2s_legacy_pos >= fp.size()) || 
+      (SD_n2s_legacy_pos && (!fp.seek(SD_n2s_legacy_pos - 1) || (fp.read() != 0x0A)))) {
+    SD_n2s_legacy_pos = 0;
+  }
+  fp.seek(SD_n2s_legacy_pos);
+
+  while (fp.available()) {
+    ch = fp.read();
+    if (ch == 0x0A) {  // newline
+      msgbuf[i] = 0;
+      if ((i > 0) && !toolong && (msgbuf[0] == '{')) {
+        if (!Particle_Publish((char *) "SG")) {
+          sprintf (Buffer32Bytes, "N2S[%d]->PUB:ERR", sent);
+          Output (Buffer32Bytes);
+          fp.close();
+          return (false);  // Pick up from this line next time
+        }
+        sent++;
+        Serial_write (msgbuf);
+      }
+      else if (i) {
+        bad++;  // Too long or not an observation
+      }
+      SD_n2s_legacy_pos = fp.position();
+      i = 0;
+      toolong = false;
+    }
+    else if (ch != 0x0D) {
+      if (i < MAX_MSGBUF_SIZE-1) {
+        msgbuf[i++] = ch;
+      }
+      else {
+        toolong = true;
+      }
+    }
+  }
+  fp.close();
+
+  SD.remove (SD_n2s_legacy_file);
+  SD_n2s_legacy_pos = 0;
+  sprintf (Buffer32Bytes, "N2S:Legacy Sent %d Bad %d", sent, bad);
+  Output (Buffer32Bytes);
+  return (true);
 }
 
 /* 
@@ -154,112 +482,82 @@ void SD_NeedToSend_Add(char *observation) {
  */
 void SD_N2S_Publish() {
   File fp;
-  char ch;
-  int i;
+  char *event = (char *) (cf_n2s_batch ? "SGB" : "SG");
+  uint32_t pos;
+  int n = 0;
   int sent=0;
 
-  if (SD_exists && SD.exists(SD_n2s_file)) {
-    Output ("N2S:Publish");
+  // Older firmware's backlog goes first, if that is failing the ring waits for next time
+  if (!SD_N2S_Legacy()) {
+    return;
+  }
 
-    fp = SD.open(SD_n2s_file, FILE_READ); // Open the file for reading, starting at the beginning of the file.
+  if (!SD_exists || !eeprom_valid || !eeprom.n2s_count) {
+    return;
+  }
 
-    if (fp) {
-      // Delete Empty File or too small of file to be valid
-      if (fp.size()<=20) {
-        fp.close();
-        Output ("N2S:Empty");
-        SD_N2S_Delete();
-      }
-      else {
-        if (eeprom.n2sfp) {
-          if (fp.size()<=eeprom.n2sfp) {
-            // Something wrong. Can not have a file position that is larger than the file
-            eeprom.n2sfp = 0; 
-          }
-          else {
-            fp.seek(eeprom.n2sfp);  // Seek to where we left off last time. 
-          }
-        }
+  Output ("N2S:Publish");
 
-        // Loop through each line / obs and transmit
-        i = 0;
-        while (fp.available() && (i < MAX_MSGBUF_SIZE )) {
-          ch = fp.read();
-
-          if (ch == 0x0A) {  // newline
-
-            if (Particle_Publish((char *) "SG")) {
-              sprintf (Buffer32Bytes, "N2S[%d]->PUB:OK", sent++);
-              Output (Buffer32Bytes);
-              Serial_write (msgbuf);
-
-              // setup for next line in file
-              i = 0;
-
-              // file position is at the start of the next observation or at eof
-              eeprom.n2sfp = fp.position();           
-            }
-            else { // Delay then retry 
-              sprintf (Buffer32Bytes, "N2S[%d]->PUB:RETRY", sent);
-              Output (Buffer32Bytes);
-              Serial_write (msgbuf);
-
-              delay (5000); // Throttle a little while
-
-              if (Particle_Publish((char *) "SG")) {
-                sprintf (Buffer32Bytes, "N2S[%d]->PUB:OK", sent++);
-                Output (Buffer32Bytes);
-                // setup for next line in file
-                i = 0;
-
-                // file position is at the start of the next observation or at eof
-                eeprom.n2sfp = fp.position();
-              }
-              else {
-                sprintf (Buffer32Bytes, "N2S[%d]->PUB:ERR", sent);
-                Output (Buffer32Bytes);
-                // On transmit failure, stop processing file.
-                break;
-              }
-            } // RETRY
-            
-            // At this point file pointer's position is at the first character of the next line or at eof
-          } // Newline
-          else if (ch == 0x0D) { // CR
-            msgbuf[i] = 0; // null terminate then wait for newline to be read to process OBS
-          }
-          else {
-            msgbuf[i++] = ch;
-          }
-
-          // Check for buffer OverRun
-          if (i >= MAX_MSGBUF_SIZE) {
-            sprintf (Buffer32Bytes, "N2S[%d]->BOR:ERR", sent);
-            Output (Buffer32Bytes);
-            fp.close();
-            SD_N2S_Delete(); // Bad data in the file so delete the file           
-            return;
-          }
-        } // end while 
-
-        if (fp.available() <= 20) {
-          // If at EOF or some invalid amount left then delete the file
-          fp.close();
-          SD_N2S_Delete();
-        }
-        else {
-          // At this point we sent 0 or more observations but there was a problem.
-          // eeprom.n2sfp was maintained in the above read loop. So we will close the
-          // file and next time this function is called we will seek to eeprom.n2sfp
-          // and start processing from there forward. 
-          fp.close();
-          EEPROM_Update(); // Update file postion in the eeprom.
-        }
+  if (!SD_N2S_Open(fp)) {
+    Output ("N2S->OPEN:ERR");
+    return;
+  }
+
+  // Loop through the records a batch at a time from the tail and transmit
+  pos = eeprom.n2s_tail;
+  while ((n = SD_N2S_Batch(fp, &pos, eeprom.n2s_count)) != 0) {
+    if (n < 0) {
+      // Bad record at the tail, skip to the next good one. The ring only starts over when none is left.
+      sprintf (Buffer32Bytes, "N2S[%d]->REC:ERR", sent);
+      Output (Buffer32Bytes);
+      eeprom.n2s_count = SD_N2S_Skip(fp, &pos);
+      if (eeprom.n2s_count == 0) {
+        break;
       }
+      eeprom.n2s_tail = pos;
+      EEPROM_Update(); // Checkpoint the tail
+      continue;
     }
-    else {
-        Output ("N2S->OPEN:ERR");
+
+    if (Particle_Publish(event)) {
+      sent += n;
+      sprintf (Buffer32Bytes, "N2S[%d]->PUB:OK", sent);
+      Output (Buffer32Bytes);
+      Serial_write (msgbuf);
+    }
+    else { // Delay then retry 
+      sprintf (Buffer32Bytes, "N2S[%d]->PUB:RETRY", sent);
+      Output (Buffer32Bytes);
+      Serial_write (msgbuf);
+
+      delay (5000); // Throttle a little while
+
+      if (Particle_Publish(event)) {
+        sent += n;
+        sprintf (Buffer32Bytes, "N2S[%d]->PUB:OK", sent);
+        Output (Buffer32Bytes);
+      }
+      else {
+        sprintf (Buffer32Bytes, "N2S[%d]->PUB:ERR", sent);
+        Output (Buffer32Bytes);
+        // On transmit failure, stop processing. We pick up from the tail next time.
+        break;
+      }
+    } // RETRY
+
+    // pos is at the start of the next batch. Checkpoint it now, a reset during a long drain would otherwise
+    // publish every batch already sent again.
+    eeprom.n2s_tail = pos;
+    eeprom.n2s_count -= n;
+    EEPROM_Update();
+  } // end while 
+  fp.close();
+
+  if (eeprom.n2s_count == 0) {
+    if (n < 0) {
+      SD_N2S_Reset(); // No good record left in the ring so start over
     }
+    SystemStatusBits &= ~SSB_N2S; // Turn Off Bit
   }
 }
 
@@ -310,7 +608,7 @@ int SD_findKey(const __FlashStringHelper * key, char * value) {
     // UNIX uses LF = \n
     // WINDOWS uses CFLF = \r\n
     int buffer_length = configFile.readBytesUntil('\n', SD_buffer, LINE_MAX_LENGTH);
-    if (SD_buffer[buffer_length - 1] == '\r')
+    if (buffer_length > 0 && SD_buffer[buffer_length - 1] == '\r')
       buffer_length--; // trim the \r
 
     if (buffer_length > (key_length + 1)) { // 1 is = character
@@ -455,5 +753,139 @@ long SD_findLong(const __FlashStringHelper * key) {
  * =======================================================================================================================
  */
 void SD_ReadConfigFile() {
+  FMT_BUF f;
+
+  if (!SD_exists || !SD.exists(CF_NAME)) {
+    Output ("CF:NF Using Defaults");
+    return;
+  }
+
+  Output ("CF:Reading");
+
+  if (SD_available(F("awake_budget"))) {
+    cf_awake_budget = SD_findInt(F("awake_budget"));
+  }
+  sprintf (msgbuf, "CF:awake_budget=%d", cf_awake_budget);
+  Output (msgbuf);
+
+  if (SD_available(F("perf"))) {
+    cf_perf = SD_findInt(F("perf"));
+  }
+  sprintf (msgbuf, "CF:perf=%d", cf_perf);
+  Output (msgbuf);
+
+  if (SD_available(F("ma_awake"))) {
+    cf_ma_awake = SD_findFloat(F("ma_awake"));
+  }
+  if (SD_available(F("ma_modem"))) {
+    cf_ma_modem = SD_findFloat(F("ma_modem"));
+  }
+  if (SD_available(F("ma_sleep"))) {
+    cf_ma_sleep = SD_findFloat(F("ma_sleep"));
+  }
+  fmt_begin(&f, msgbuf, sizeof(msgbuf));
+  fmt_str(&f, "CF:mA ");
+  fmt_float(&f, cf_ma_awake, 2);
+  fmt_char(&f, ' ');
+  fmt_float(&f, cf_ma_modem, 2);
+  fmt_char(&f, ' ');
+  fmt_float(&f, cf_ma_sleep, 2);
+  Output (msgbuf);
+
+  if (SD_available(F("dg_mad"))) {
+    cf_dg_mad = SD_findInt(F("dg_mad"));
+  }
+  if (SD_available(F("dg_min"))) {
+    cf_dg_min = SD_findInt(F("dg_min"));
+  }
+  if (SD_available(F("dg_stable"))) {
+    cf_dg_stable = SD_findInt(F("dg_stable"));
+  }
+  if (SD_available(F("dg_max"))) {
+    cf_dg_max = SD_findInt(F("dg_max"));
+  }
+  cf_dg_max = constrain(cf_dg_max, 3, DG_MAX_BUCKETS);
+  cf_dg_min = constrain(cf_dg_min, 3, cf_dg_max);
+  cf_dg_stable = constrain(cf_dg_stable, 1, cf_dg_max);
+  sprintf (msgbuf, "CF:dg %d %d %d %d", cf_dg_mad, cf_dg_min, cf_dg_stable, cf_dg_max);
+  Output (msgbuf);
+
+  if (SD_available(F("dg_stats"))) {
+    cf_dg_stats = SD_findInt(F("dg_stats"));
+  }
+  sprintf (msgbuf, "CF:dg_stats=%d", cf_dg_stats);
+  Output (msgbuf);
+
+  if (SD_available(F("dg_burst"))) {
+    cf_dg_burst = SD_findInt(F("dg_burst"));
+  }
+  if (SD_available(F("dg_burst_n"))) {
+    cf_dg_burst_n = SD_findInt(F("dg_burst_n"));
+  }
+  if (cf_dg_burst) {
+    cf_dg_burst = constrain(cf_dg_burst, 10, 450);
+  }
+  cf_dg_burst_n = constrain(cf_dg_burst_n, 1, 32);
+  sprintf (msgbuf, "CF:dg_burst=%d,%d", cf_dg_burst, cf_dg_burst_n);
+  Output (msgbuf);
+
+  if (SD_available(F("rr_rate"))) {
+    cf_rr_rate = SD_findInt(F("rr_rate"));
+  }
+  if (SD_available(F("rr_cadence"))) {
+    cf_rr_cadence = SD_findInt(F("rr_cadence"));
+  }
+  if (SD_available(F("rr_hold"))) {
+    cf_rr_hold = SD_findInt(F("rr_hold"));
+  }
+  if ((cf_rr_cadence < 60) || (cf_rr_cadence > 900) || (900 % cf_rr_cadence)) {
+    cf_rr_cadence = 60; // Must keep observations aligned to the 15m window
+  }
+  cf_rr_hold = constrain(cf_rr_hold, 1, 96);
+  sprintf (msgbuf, "CF:rr %d %d %d", cf_rr_rate, cf_rr_cadence, cf_rr_hold);
+  Output (msgbuf);
+
+  // Bosch BMP280/BME280 forced mode and oversampling
+  if (SD_available(F("bmx_forced"))) {
+    cf_bmx_forced = SD_findInt(F("bmx_forced"));
+  }
+  if (SD_available(F("bmx_osrs_t"))) {
+    cf_bmx_osrs_t = SD_findInt(F("bmx_osrs_t"));
+  }
+  if (SD_available(F("bmx_osrs_p"))) {
+    cf_bmx_osrs_p = SD_findInt(F("bmx_osrs_p"));
+  }
+  if (SD_available(F("bmx_osrs_h"))) {
+    cf_bmx_osrs_h = SD_findInt(F("bmx_osrs_h"));
+  }
+  if (SD_available(F("bmx_filter"))) {
+    cf_bmx_filter = SD_findInt(F("bmx_filter"));
+  }
+  cf_bmx_osrs_t = constrain(cf_bmx_osrs_t, 1, 16);
+  cf_bmx_osrs_p = constrain(cf_bmx_osrs_p, 1, 16);
+  cf_bmx_osrs_h = constrain(cf_bmx_osrs_h, 0, 16);
+  cf_bmx_filter = constrain(cf_bmx_filter, 0, 16);
+  sprintf (msgbuf, "CF:bmx %d %d %d %d %d", cf_bmx_forced, cf_bmx_osrs_t, cf_bmx_osrs_p, cf_bmx_osrs_h, cf_bmx_filter);
+  Output (msgbuf);
+
+  if (SD_available(F("n2s_batch"))) {
+    cf_n2s_batch = SD_findInt(F("n2s_batch"));
+  }
+  cf_n2s_batch = constrain(cf_n2s_batch, 0, 1);
+  sprintf (msgbuf, "CF:n2s_batch=%d", cf_n2s_batch);
+  Output (msgbuf);
 
+  if (SD_available(F("sg_compact"))) {
+    cf_sg_compact = SD_findInt(F("sg_compact"));
+  }
+  cf_sg_compact = constrain(cf_sg_compact, 0, 1);
+  sprintf (msgbuf, "CF:sg_compact=%d", cf_sg_compact);
+  Output (msgbuf);
+
+  if (SD_available(F("sd_log"))) {
+    cf_sd_log = SD_findInt(F("sd_log"));
+  }
+  cf_sd_log = constrain(cf_sd_log, 0, 2);
+  sprintf (msgbuf, "CF:sd_log=%d", cf_sd_log);
+  Output (msgbuf);
 }
@@ -6,36 +6,211 @@
 
 // Prototyping functions to aviod compile function unknown issue.
 void Output(const char *str);
+unsigned int sensors_ssb_mask();
+
+/*
+ * ======================================================================================================================
+ *  I2C Transactions
+ * 
+ *  Register and probe traffic that is not inside a sensor driver goes through I2C_Transaction(). Each transfer
+ *  has a I2C_TIMEOUT_MS deadline. When one fails and SDA is being held low by a device that lost its place,
+ *  the bus is recovered with 9 SCL pulses and a STOP, then Wire is reset.
+ * 
+ *  Per address counters of transactions, latency, NACKs and timeouts are kept for the first I2C_STATS_MAX
+ *  addresses used and reported by INFO_Do(). Latency buckets are <250us, <1ms, <4ms, <16ms, >=16ms.
+ * ======================================================================================================================
+ */
+#define I2C_TIMEOUT_MS    25            // Deadline for one transfer
+#define I2C_STATS_MAX     12            // Addresses we keep counters for
+#define I2C_HIST          5             // Latency buckets
+
+typedef struct {
+  byte address;
+  uint32_t count;                       // Transactions
+  uint32_t nacks;                       // Address or data not acknowledged
+  uint32_t timeouts;                    // Over the deadline or a bus error
+  uint32_t hist[I2C_HIST];              // Latency histogram
+} I2C_STATS;
+
+I2C_STATS i2c_stats[I2C_STATS_MAX];
+int i2c_stats_n = 0;                    // Addresses in use in i2c_stats[]
+uint32_t i2c_recoveries = 0;            // Stuck bus recoveries since boot
 
 /* 
  *=======================================================================================================================
- * I2C_Device_Exist - does i2c device exist
- * 
- *  The i2c_scanner uses the return value of the Write.endTransmisstion to see 
- *  if a device did acknowledge to the address.
+ * I2C_Stats() - Counters for an address, NULL if the table is full
  *=======================================================================================================================
  */
-bool I2C_Device_Exist(byte address) {
-  byte error;
+I2C_STATS *I2C_Stats(byte address) {
+  for (int i=0; i<i2c_stats_n; i++) {
+    if (i2c_stats[i].address == address) {
+      return (&i2c_stats[i]);
+    }
+  }
+  if (i2c_stats_n < I2C_STATS_MAX) {
+    I2C_STATS *st = &i2c_stats[i2c_stats_n++];
+    memset(st, 0, sizeof(I2C_STATS));
+    st->address = address;
+    return (st);
+  }
+  return (NULL);
+}
+
+/* 
+ *=======================================================================================================================
+ * I2C_Line() - Drive an I2C line low or release it to the pullup, wait half a bit at 100kHz
+ *
+ *  The lines are never driven high, a device holding one low would be fighting the pin. The output is set low
+ *  before the pin becomes an output so it does not glitch high first.
+ *=======================================================================================================================
+ */
+#define I2C_HALF_US       5
+#define I2C_STRETCH_US    1000              // Longest a device may hold SCL low, clock stretching
+
+void I2C_Line(int pin, bool release) {
+  if (release) {
+    pinMode(pin, INPUT_PULLUP);
+  }
+  else {
+    digitalWrite(pin, LOW);
+    pinMode(pin, OUTPUT);
+  }
+  delayMicroseconds(I2C_HALF_US);
+}
+
+/* 
+ *=======================================================================================================================
+ * I2C_SCL_Release() - Release SCL and wait for a clock stretching device to let it go, false if it does not
+ *=======================================================================================================================
+ */
+bool I2C_SCL_Release() {
+  unsigned long start = micros();
 
-  Wire.begin();                     // Connect to I2C as Master (no addess is passed to signal being a slave)
+  I2C_Line(SCL, true);
+  while (digitalRead(SCL) == LOW) {
+    if (micros() - start > I2C_STRETCH_US) {
+      return (false);
+    }
+  }
+  return (true);
+}
+
+/* 
+ *=======================================================================================================================
+ * I2C_Recover() - If a device is holding SDA low, clock it out with up to 9 SCL pulses, when SDA comes free send a
+ *                 STOP, then reset Wire
+ *=======================================================================================================================
+ */
+bool I2C_Recover() {
+  bool stuck;
+
+  // Release the pins from Wire to look at SDA
+  Wire.end();
+  pinMode(SCL, INPUT_PULLUP);
+  pinMode(SDA, INPUT_PULLUP);
+  stuck = (digitalRead(SDA) == LOW);
 
-  Wire.beginTransmission(address);  // Begin a transmission to the I2C slave device with the given address. 
-                                    // Subsequently, queue bytes for transmission with the write() function 
-                                    // and transmit them by calling endTransmission(). 
+  if (stuck) {
+    Output ("I2C:RECOVER");
+    i2c_recoveries++;
+
+    for (int i=0; i<9 && (digitalRead(SDA) == LOW); i++) {
+      I2C_Line(SCL, false);
+      if (!I2C_SCL_Release()) {
+        break;
+      }
+    }
+
+    if (digitalRead(SDA) == HIGH) {
+      // STOP is SDA going high while SCL is high
+      I2C_Line(SCL, false);
+      I2C_Line(SDA, false);
+      if (I2C_SCL_Release()) {
+        I2C_Line(SDA, true);
+      }
+    }
+    else {
+      Output ("I2C:STILL STUCK");
+    }
+    pinMode(SCL, INPUT_PULLUP);
+    pinMode(SDA, INPUT_PULLUP);
+
+    Wire.reset();
+  }
+  Wire.begin();
+  return (stuck);
+}
 
-  error = Wire.endTransmission();   // Ends a transmission to a slave device that was begun by beginTransmission() 
-                                    // and transmits the bytes that were queued by write()
-                                    // By default, endTransmission() sends a stop message after transmission, 
-                                    // releasing the I2C bus.
+/* 
+ *=======================================================================================================================
+ * I2C_Transaction() - Write wn bytes then read rn bytes, no bytes is a probe. Returns 0 on success.
+ *
+ *  Return values are those of Wire.endTransmission(), or I2C_ERR_READ when fewer than rn bytes were read.
+ *  SEE https://docs.particle.io/cards/firmware/wire-i2c/endtransmission/ and the table in I2C_Device_Exist().
+ *  The address (3) or a data byte (4) not being acknowledged, or a short read, is counted as a NACK. The device
+ *  is not answering but the bus is fine. Busy and START timeouts (1, 2, 5, 6) or going over the deadline are
+ *  counted as timeouts, and only then, if SDA is being held low, is the bus recovered.
+ *=======================================================================================================================
+ */
+#define I2C_ERR_READ      7
+
+byte I2C_Transaction(byte address, const byte *wbuf, int wn, byte *rbuf, int rn) {
+  I2C_STATS *st = I2C_Stats(address);
+  unsigned long start = micros();
+  byte error = 0;
+
+  if (!Wire.isEnabled()) {
+    Wire.begin();
+  }
+
+  if (wn || !rn) {
+    Wire.beginTransmission(WireTransmission(address).timeout(I2C_TIMEOUT_MS));
+    if (wn) {
+      Wire.write(wbuf, wn);
+    }
+    error = Wire.endTransmission();
+  }
+
+  if (!error && rn) {
+    if (Wire.requestFrom(WireTransmission(address).quantity(rn).timeout(I2C_TIMEOUT_MS)) == (size_t) rn) {
+      for (int i=0; i<rn; i++) {
+        rbuf[i] = Wire.read();
+      }
+    }
+    else {
+      error = I2C_ERR_READ;
+    }
+  }
+
+  unsigned long us = micros() - start;
+  bool nack = (error == 3) || (error == 4) || (error == I2C_ERR_READ);
+  bool timeout = !nack && (error || (us >= I2C_TIMEOUT_MS * 1000UL));
+  if (st) {
+    st->count++;
+    st->hist[(us < 250) ? 0 : (us < 1000) ? 1 : (us < 4000) ? 2 : (us < 16000) ? 3 : 4]++;
+    if (nack) {
+      st->nacks++;
+    }
+    else if (timeout) {
+      st->timeouts++;
+    }
+  }
 
-  // endTransmission() returns a byte, which indicates the status of the transmission
-  //  0:success
-  //  1:data too long to fit in transmit buffer
-  //  2:received NACK on transmit of address
-  //  3:received NACK on transmit of data
-  //  4:other error 
+  if (timeout && (digitalRead(SDA) == LOW)) {
+    I2C_Recover();
+  }
+  return (error);
+}
 
+/* 
+ *=======================================================================================================================
+ * I2C_Device_Exist - does i2c device exist
+ * 
+ *  The i2c_scanner uses the return value of the Write.endTransmisstion to see 
+ *  if a device did acknowledge to the address.
+ *=======================================================================================================================
+ */
+bool I2C_Device_Exist(byte address) {
   // Partice Library Return values
   // SEE https://docs.particle.io/cards/firmware/wire-i2c/endtransmission/
   // 0: success
@@ -46,14 +221,7 @@ bool I2C_Device_Exist(byte address) {
   // 5: data byte transfer succeeded, busy timeout immediately after
   // 6: timeout waiting for peripheral to clear stop bit
 
-  if (error == 0) {
-    return (true);
-  }
-  else {
-    // sprintf (msgbuf, "I2CERR: %d", error);
-    // Output (msgbuf);
-    return (false);
-  }
+  return (I2C_Transaction(address, NULL, 0, NULL, 0) == 0);
 }
 
 /*
@@ -112,18 +280,87 @@ void myswap(unsigned int *p, unsigned int *q) {
 
 /*
  * ======================================================================================================================
- * mysort()
+ * myselect() - Return the k'th smallest value (0 based), a[] is left partially ordered around k
+ * 
+ *  Quickselect with a median of three pivot and a three way partition so runs of equal ADC readings,
+ *  which are common, do not degrade it. Average O(n) and works in place with no allocation.
  * ======================================================================================================================
  */
-void mysort(unsigned int a[], unsigned int n) { 
-  unsigned int i, j;
+unsigned int myselect(unsigned int a[], unsigned int n, unsigned int k) {
+  int lo = 0;
+  int hi = n-1;
 
-  for(i = 0;i < n-1;i++) {
-    for(j = 0;j < n-i-1;j++) {
-      if(a[j] > a[j+1])
-        myswap(&a[j],&a[j+1]);
+  if (n <= 0) {
+    return (0);
+  }
+  if (k >= n) {
+    k = n-1;
+  }
+  while (lo < hi) {
+    int mid = lo + (hi-lo)/2;
+    unsigned int x = a[lo], y = a[mid], z = a[hi];
+    unsigned int pivot = (x < y) ? ((y < z) ? y : ((x < z) ? z : x)) : ((x < z) ? x : ((y < z) ? z : y));
+
+    // a[lo..lt-1] < pivot, a[lt..gt] == pivot, a[gt+1..hi] > pivot
+    int lt = lo, i = lo, gt = hi;
+    while (i <= gt) {
+      if (a[i] < pivot) {
+        myswap(&a[lt++], &a[i++]);
+      }
+      else if (a[i] > pivot) {
+        myswap(&a[i], &a[gt--]);
+      }
+      else {
+        i++;
+      }
+    }
+
+    if ((int) k < lt) {
+      hi = lt-1;
+    }
+    else if ((int) k > gt) {
+      lo = gt+1;
     }
+    else {
+      return (pivot);
+    }
+  }
+  return (a[k]);
+}
+
+/*
+ * ======================================================================================================================
+ * mypercentile() - Return the nearest rank percentile (0-100) of a[], a[] is left partially ordered
+ * ======================================================================================================================
+ */
+unsigned int mypercentile(unsigned int a[], unsigned int n, int pct) {
+  int k = ((pct * n) + 99) / 100 - 1; // -1 as array indexing in C starts from 0
+
+  if (n <= 0) {
+    return (0);
+  }
+  if (k < 0) {
+    k = 0;
   }
+  return (myselect(a, n, k));
+}
+
+/*
+ * ======================================================================================================================
+ * mymad() - Return the median absolute deviation of a[], a[] is overwritten with the deviations
+ * ======================================================================================================================
+ */
+unsigned int mymad(unsigned int a[], unsigned int n) {
+  if (n <= 0) {
+    return (0);
+  }
+
+  unsigned int median = myselect(a, n, (n+1) / 2 - 1);
+
+  for (unsigned int i=0; i<n; i++) {
+    a[i] = (a[i] > median) ? (a[i] - median) : (median - a[i]);
+  }
+  return (myselect(a, n, (n+1) / 2 - 1));
 }
 
 /*
@@ -230,6 +467,338 @@ void hexStringToByteArray(const char *hexString, uint8_t *byteArray, int len) {
     }
 }
 
+/*
+ * ======================================================================================================================
+ *  Fixed Point Number Formatting
+ *
+ *  Numbers for the OLED, Output, SD and the JSON events are written with these and not sprintf(). A float is
+ *  scaled by 10^precision to an int32 and rounded, then written as sign, integer digits, '.' and the fraction
+ *  digits. The (int)x, (int)(x*100)%100 pattern this replaces dropped the sign between -1 and 0 and wrote
+ *  negative fractions as "-1.-50".
+ *
+ *  Text is appended to an FMT_BUF over a caller's buffer, nothing is allocated. What does not fit is dropped,
+ *  len keeps counting so fmt_overflow() can tell, and the buffer is always null terminated.
+ * ======================================================================================================================
+ */
+#define FMT_PRECISION_MAX  4
+
+typedef struct {
+  char *buf;
+  size_t size;                        // Buffer size including the null
+  size_t len;                         // Characters appended, more than fit when truncated
+  char last;                          // Last character appended, for JSON separators
+} FMT_BUF;
+
+const int32_t fmt_pow10[FMT_PRECISION_MAX+1] = {1, 10, 100, 1000, 10000};
+
+/*
+ * ======================================================================================================================
+ * fmt_begin() - Start appending to buf
+ * ======================================================================================================================
+ */
+void fmt_begin(FMT_BUF *f, char *buf, size_t size) {
+  f->buf = buf;
+  f->size = size;
+  f->len = 0;
+  f->last = 0;
+  buf[0] = 0;
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_overflow() - True if some of what was appended did not fit
+ * ======================================================================================================================
+ */
+bool fmt_overflow(FMT_BUF *f) {
+  return (f->len >= f->size);
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_char() - Append a character
+ * ======================================================================================================================
+ */
+void fmt_char(FMT_BUF *f, char c) {
+  if (f->len + 1 < f->size) {
+    f->buf[f->len] = c;
+    f->buf[f->len + 1] = 0;
+  }
+  f->len++;
+  f->last = c;
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_str() - Append a string
+ * ======================================================================================================================
+ */
+void fmt_str(FMT_BUF *f, const char *s) {
+  while (*s) {
+    fmt_char(f, *s++);
+  }
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_uint() - Append an unsigned integer
+ * ======================================================================================================================
+ */
+void fmt_uint(FMT_BUF *f, uint32_t v) {
+  char d[10];
+  int n = 0;
+
+  do {
+    d[n++] = '0' + (v % 10);
+    v /= 10;
+  } while (v);
+  while (n) {
+    fmt_char(f, d[--n]);
+  }
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_int() - Append an integer
+ * ======================================================================================================================
+ */
+void fmt_int(FMT_BUF *f, int32_t v) {
+  if (v < 0) {
+    fmt_char(f, '-');
+    fmt_uint(f, -(uint32_t) v);
+  }
+  else {
+    fmt_uint(f, v);
+  }
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_hex() - Append an unsigned integer in upper case hex, zero padded to width
+ * ======================================================================================================================
+ */
+void fmt_hex(FMT_BUF *f, uint32_t v, int width) {
+  char d[8];
+  int n = 0;
+
+  do {
+    d[n++] = "0123456789ABCDEF"[v & 0xF];
+    v >>= 4;
+  } while (v);
+  while (n < width && n < 8) {
+    d[n++] = '0';
+  }
+  while (n) {
+    fmt_char(f, d[--n]);
+  }
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_uint_pad() - Append an unsigned integer zero padded to width
+ * ======================================================================================================================
+ */
+void fmt_uint_pad(FMT_BUF *f, uint32_t v, int width) {
+  for (uint32_t p=10; (width > 1) && (p <= 1000000000); width--, p*=10) {
+    if (v < p) {
+      fmt_char(f, '0');
+    }
+  }
+  fmt_uint(f, v);
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_timestamp() - Append a time as ISO 8601, 2024-09-24T12:15:00
+ * ======================================================================================================================
+ */
+void fmt_timestamp(FMT_BUF *f, time_t ts) {
+  fmt_uint(f, Time.year(ts));
+  fmt_char(f, '-');
+  fmt_uint_pad(f, Time.month(ts), 2);
+  fmt_char(f, '-');
+  fmt_uint_pad(f, Time.day(ts), 2);
+  fmt_char(f, 'T');
+  fmt_uint_pad(f, Time.hour(ts), 2);
+  fmt_char(f, ':');
+  fmt_uint_pad(f, Time.minute(ts), 2);
+  fmt_char(f, ':');
+  fmt_uint_pad(f, Time.second(ts), 2);
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_fixed() - Append an integer scaled by 10^precision as a decimal with precision fraction digits
+ * ======================================================================================================================
+ */
+void fmt_fixed(FMT_BUF *f, int32_t v, int precision) {
+  uint32_t a = (v < 0) ? -(uint32_t) v : v;
+
+  if (v < 0) {
+    fmt_char(f, '-');
+  }
+  fmt_uint(f, a / fmt_pow10[precision]);
+  if (precision) {
+    fmt_char(f, '.');
+    a %= fmt_pow10[precision];
+    for (int i=precision-1; i>=0; i--) {
+      fmt_char(f, '0' + (a / fmt_pow10[i]) % 10);
+    }
+  }
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_scale() - Float as an int32 scaled by 10^precision and rounded, 0 for NAN, limited to the int32 range
+ * 
+ *  The integer and fraction parts are scaled separately. v * 10^precision in one float multiply runs out of
+ *  mantissa past 2^24, 1677.7216 at 4 places. Halfway cases round away from zero. The fraction multiply can still
+ *  round onto or across a halfway point, 0.35f is 0.3499999940 and 3.4999999 rounds to 3.5, so the rounding is
+ *  checked against the exact product with fmaf(), a single VFMA on the M4F.
+ * ======================================================================================================================
+ */
+int32_t fmt_scale(float v, int precision) {
+  float limit = 2147483520.0f / fmt_pow10[precision];   // 2147483520 is the largest float under 2^31
+  float p = fmt_pow10[precision];
+  float ip, fp;
+  int32_t n;
+
+  if (isnan(v)) {
+    return (0);
+  }
+  if (v >= limit) {
+    return (INT32_MAX);
+  }
+  if (v <= -limit) {
+    return (-INT32_MAX);
+  }
+  ip = truncf(v);
+  fp = fabsf(v - ip);
+  n = lroundf(fp * p);
+  if ((n > 0) && (fmaf(fp, p, 0.5f - n) < 0)) {
+    n--;
+  }
+  else if (fmaf(fp, p, -0.5f - n) >= 0) {
+    n++;
+  }
+  return (((int32_t) ip * fmt_pow10[precision]) + ((v < 0) ? -n : n));
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_float() - Append a float with precision fraction digits, "nan", "inf" or "-inf" as printf() writes them
+ * ======================================================================================================================
+ */
+void fmt_float(FMT_BUF *f, float v, int precision) {
+  if (isnan(v)) {
+    fmt_str(f, "nan");
+    return;
+  }
+  if (isinf(v)) {
+    fmt_str(f, (v > 0) ? "inf" : "-inf");
+    return;
+  }
+  fmt_fixed(f, fmt_scale(v, precision), precision);
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_json_key() - Append a JSON object key, with the comma when it is not the first in the object
+ * ======================================================================================================================
+ */
+void fmt_json_key(FMT_BUF *f, const char *key) {
+  if (f->last && (f->last != '{')) {
+    fmt_char(f, ',');
+  }
+  fmt_char(f, '"');
+  fmt_str(f, key);
+  fmt_str(f, "\":");
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_json_int() - Append a JSON integer member
+ * ======================================================================================================================
+ */
+void fmt_json_int(FMT_BUF *f, const char *key, int32_t v) {
+  fmt_json_key(f, key);
+  fmt_int(f, v);
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_json_uint() - Append a JSON unsigned integer member
+ * ======================================================================================================================
+ */
+void fmt_json_uint(FMT_BUF *f, const char *key, uint32_t v) {
+  fmt_json_key(f, key);
+  fmt_uint(f, v);
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_json_float() - Append a JSON number member with precision fraction digits, null for NAN and infinity
+ * ======================================================================================================================
+ */
+void fmt_json_float(FMT_BUF *f, const char *key, float v, int precision) {
+  fmt_json_key(f, key);
+  if (isnan(v) || isinf(v)) {
+    fmt_str(f, "null");
+    return;
+  }
+  fmt_float(f, v, precision);
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_json_object() - Append a JSON member that is an object, the caller closes it with fmt_char(f, '}')
+ * ======================================================================================================================
+ */
+void fmt_json_object(FMT_BUF *f, const char *key) {
+  fmt_json_key(f, key);
+  fmt_char(f, '{');
+}
+
+/*
+ * ======================================================================================================================
+ * fmt_json_string() - Append a JSON string member, escaping quotes, backslashes and control characters
+ * ======================================================================================================================
+ */
+void fmt_json_string(FMT_BUF *f, const char *key, const char *s) {
+  fmt_json_key(f, key);
+  fmt_char(f, '"');
+  for (; *s; s++) {
+    if ((*s == '"') || (*s == '\\')) {
+      fmt_char(f, '\\');
+      fmt_char(f, *s);
+    }
+    else if ((unsigned char) *s < 0x20) {
+      fmt_str(f, "\\u00");
+      fmt_hex(f, (unsigned char) *s, 2);
+    }
+    else {
+      fmt_char(f, *s);
+    }
+  }
+  fmt_char(f, '"');
+}
+
+/*
+ * ======================================================================================================================
+ * crc16() - CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of n bytes
+ * ======================================================================================================================
+ */
+uint16_t crc16(const uint8_t *p, int n) {
+  uint16_t crc = 0xFFFF;
+
+  while (n--) {
+    crc ^= (uint16_t) *p++ << 8;
+    for (int i=0; i<8; i++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+  }
+  return (crc);
+}
+
 /*
  * ======================================================================================================================
  * JPO_ClearBits() - Clear System Status Bits related to initialization
@@ -240,16 +809,7 @@ void JPO_ClearBits() {
     JustPoweredOn = false;
     SystemStatusBits &= ~SSB_PWRON;   // Turn Off Power On Bit
     SystemStatusBits &= ~SSB_OLED;    // Turn Off OLED Missing Bit
-    SystemStatusBits &= ~SSB_BMX_1;   // Turn Off BMX280_1 Not Found Bit
-    SystemStatusBits &= ~SSB_BMX_2;   // Turn Off BMX280_1 Not Found Bit
-    SystemStatusBits &= ~SSB_HTU21DF; // Turn Off HTU Not Found Bit
-    SystemStatusBits &= ~SSB_MCP_1;   // Turn Off MCP_1 Not Found Bit
-    SystemStatusBits &= ~SSB_MCP_2;   // Turn Off MCP_2 Not Found Bit
-    SystemStatusBits &= ~SSB_SHT_1;   // Turn Off SHT_1 Not Found Bit
-    SystemStatusBits &= ~SSB_SHT_2;   // Turn Off SHT_1 Not Found Bit
-    SystemStatusBits &= ~SSB_HIH8;    // Turn Off HIH Not Found Bit
-    SystemStatusBits &= ~SSB_LUX;     // Turn Off VEML7700 Not Found Bit
-    SystemStatusBits &= ~SSB_SI1145;  // Turn Off UV,IR, VIS Not Found Bit
+    SystemStatusBits &= ~sensors_ssb_mask(); // Turn Off Sensor Not Found Bits
   }
 }
 
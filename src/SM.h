@@ -4,264 +4,113 @@
  * ======================================================================================================================
  */
 
+/*
+ * ======================================================================================================================
+ *  Preview Mode
+ * 
+ *  loop() calls StationMonitor() every SM_PREVIEW_MS. Each pass takes one distance sample into the rolling window,
+ *  DG_RollAdd(), and refreshes the distance line with the sample and the window median, so a sensor being aimed
+ *  shows the change within a second. The time, signal and sensor lines are refreshed every SM_SENSOR_PASSES.
+ *  The VEML7700 search steps along with the passes, lux_monitor(), and the sensor line shows its last result.
+ * ======================================================================================================================
+ */
+#define SM_PREVIEW_MS       250     // Station Monitor refresh, 4Hz
+#define SM_SENSOR_PASSES    8       // Passes between refreshing the time, signal and sensor lines
+
+/*
+ * ======================================================================================================================
+ * SM_Line() - Set a line of the OLED, blank padded, and send it to the serial console
+ * ======================================================================================================================
+ */
+void SM_Line(int r, const char *str) {
+  int c, len;
+
+  len = (strlen (str) > 21) ? 21 : strlen (str);
+  for (c=0; c<len; c++) oled_lines [r][c] = *(str+c);
+  for (; c<22; c++) oled_lines [r][c] = ' ';
+  oled_lines [r][c] = (char) NULL;
+  Serial_writeln (str);
+}
+
 /*
  * ======================================================================================================================
  * StationMonitor() - On OLED display station information
  * ======================================================================================================================
  */
 void StationMonitor() {
+  static int pass = 0;
   static int cycle = 0;
-  int r, c, len;
-
-  // Clear display with spaces
-  for (r=0; r<4; r++) {
-    for (c=0; c<22; c++) {
-      oled_lines [r][c] = ' ';
-    }
-    oled_lines [r][c] = (char) NULL;
-  }
-  
-  // =================================================================
-  // Line 0 of OLED
-  // =================================================================
-  stc_timestamp();
-  len = (strlen (timestamp) > 21) ? 21 : strlen (timestamp);
-  for (c=0; c<=len; c++) oled_lines [0][c] = *(timestamp+c);
-  Serial_writeln (timestamp);
-
-  // =================================================================
-  // Line 1 of OLED Distance Median & Distance Raw
-  // =================================================================
-  memset(msgbuf, 0, sizeof(msgbuf));
-  sprintf (msgbuf+strlen(msgbuf), "DM:%d DR:%d %s", 
-    distance_gauge_median(), (int) analogRead(DISTANCEGAUGE),
-    (dg_adjustment == 1.25) ? "5M" : "10M");
-
-  len = (strlen (msgbuf) > 21) ? 21 : strlen (msgbuf);
-  for (c=0; c<=len; c++) oled_lines [1][c] = *(msgbuf+c);
-  Serial_writeln (msgbuf);
+  FMT_BUF f;
 
   // =================================================================
-  // Line 2 of OLED Signal Information
+  // Line 1 of OLED Distance Instantaneous & Rolling Median
   // =================================================================
-  memset(msgbuf, 0, sizeof(msgbuf));
-
+  unsigned int d = (int) analogRead(DISTANCEGAUGE) * dg_adjustment;
+
+  fmt_begin(&f, msgbuf, sizeof(msgbuf));
+  fmt_str(&f, "DI:");
+  fmt_uint(&f, d);
+  fmt_str(&f, " DM:");
+  fmt_uint(&f, DG_RollAdd(d));
+  fmt_str(&f, (dg_adjustment == 1.25) ? " 5M" : " 10M");
+  SM_Line(1, msgbuf);
+
+  lux_monitor();
+
+  if ((pass++ % SM_SENSOR_PASSES) == 0) {
+    // =================================================================
+    // Line 0 of OLED
+    // =================================================================
+    stc_timestamp();
+    SM_Line(0, timestamp);
+
+    // =================================================================
+    // Line 2 of OLED Signal Information
+    // =================================================================
 #if PLATFORM_ID == PLATFORM_ARGON
     WiFiSignal sig = WiFi.RSSI();
     float SignalStrength = sig.getStrength();
-    int BatteryState = 0;
 #else
     CellularSignal sig = Cellular.RSSI();
     float SignalStrength = sig.getStrength();
 #endif
 
-    sprintf (msgbuf+strlen(msgbuf), "%c S:%d.%02d H:%X",
-      (Particle.connected()) ? '+' : '-',
-      (int)SignalStrength, (int)(SignalStrength*100)%100,
-      (int)SystemStatusBits); 
-  
-  len = (strlen (msgbuf) > 21) ? 21 : strlen (msgbuf);
-  for (c=0; c<=len; c++) oled_lines [2][c] = *(msgbuf+c);
-  Serial_writeln (msgbuf);
-  
-  // =================================================================
-  // Line 3 of OLED Cycle between multiple sensors
-  // =================================================================
-  if (cycle == 0) {
-    if (BMX_1_exists) {
-      float bmx_pressure = 0.0;
-      float bmx_temp = 0.0;
-      float bmx_humid;
-      
-      switch (BMX_1_chip_id) {
-        case BMP280_CHIP_ID :
-          bmx_pressure = bmp1.readPressure()/100.0F;           // bmxp1
-          bmx_temp = bmp1.readTemperature();                   // bmxt1
-          break;
-        
-        case BME280_BMP390_CHIP_ID :
-          if (BMX_1_chip_id == BME280_BMP390_CHIP_ID) {
-            bmx_pressure = bme1.readPressure()/100.0F;           // bmxp1
-            bmx_temp = bme1.readTemperature();                   // bmxt1
-            bmx_humid = bme1.readHumidity();                     // bmxh1 
-          }
-          else { // BMP390
-            bmx_pressure = bm31.readPressure()/100.0F;
-            bmx_temp = bm31.readTemperature();
-          }
-          break;
-          
-        case BMP388_CHIP_ID :
-          bmx_pressure = bm31.readPressure()/100.0F;
-          bmx_temp = bm31.readTemperature();
-          break;
-        
-        default: // WTF
-          break;
-      }
-      sprintf (msgbuf, "B1 %d.%02d %d.%02d %d.%02d", 
-        (int)bmx_pressure, (int)(bmx_pressure*100)%100,
-        (int)bmx_temp, (int)(bmx_temp*100)%100,
-        (int)bmx_humid, (int)(bmx_humid*100)%100);
-    }
-    else {
-      sprintf (msgbuf, "B1 NF");
-    }
-  }
-  
-  if (cycle == 1) {
-    if (BMX_2_exists) {
-      float bmx_pressure = 0.0;
-      float bmx_temp = 0.0;
-      float bmx_humid;
-      
-      switch (BMX_2_chip_id) {
-        case BMP280_CHIP_ID :
-          bmx_pressure = bmp2.readPressure()/100.0F;           // bmxp1
-          bmx_temp = bmp1.readTemperature();                   // bmxt1
-          break;
-        
-        case BME280_BMP390_CHIP_ID :
-          if (BMX_2_chip_id == BME280_BMP390_CHIP_ID) {
-            bmx_pressure = bme2.readPressure()/100.0F;           // bmxp1
-            bmx_temp = bme1.readTemperature();                   // bmxt1
-            bmx_humid = bme1.readHumidity();                     // bmxh1 
-          }
-          else { // BMP390
-            bmx_pressure = bm32.readPressure()/100.0F;
-            bmx_temp = bm31.readTemperature();
-          }
-          break;
-          
-        case BMP388_CHIP_ID :
-          bmx_pressure = bm32.readPressure()/100.0F;
-          bmx_temp = bm31.readTemperature();
-          break;
-        
-        default: // WTF
-          break;
-      }
-      sprintf (msgbuf, "B2 %d.%02d %d.%02d %d.%02d", 
-        (int)bmx_pressure, (int)(bmx_pressure*100)%100,
-        (int)bmx_temp, (int)(bmx_temp*100)%100,
-        (int)bmx_humid, (int)(bmx_humid*100)%100);
-    }
-    else {
-      sprintf (msgbuf, "B2 NF");
-    }
-  }
+    fmt_begin(&f, msgbuf, sizeof(msgbuf));
+    fmt_char(&f, (Particle.connected()) ? '+' : '-');
+    fmt_str(&f, " S:");
+    fmt_float(&f, SignalStrength, 2);
+    fmt_str(&f, " H:");
+    fmt_hex(&f, SystemStatusBits, 0);
+    SM_Line(2, msgbuf);
 
-  if (cycle == 2) {
-    memset(msgbuf, 0, sizeof(msgbuf));
-      
-    if (MCP_1_exists) {
-      float mcp_temp = mcp1.readTempC();   
-      sprintf (msgbuf, "MCP1 T%d.%02d", (int)mcp_temp, (int)(mcp_temp*100)%100);
-    }
-    else {
-      sprintf (msgbuf, "MCP1 NF");
-    }
-  }
-
-  if (cycle == 3) {
-    if (MCP_2_exists) {
-      float mcp_temp = mcp2.readTempC();   
-      sprintf (msgbuf, "MCP2 T%d.%02d", (int)mcp_temp, (int)(mcp_temp*100)%100);
-    }
-    else {
-      sprintf (msgbuf, "MCP2 NF");
-    }
-  }
-
-  if (cycle == 4) {   
-    if (HTU21DF_exists) {
-      float htu_humid = htu.readHumidity();
-      float htu_temp = htu.readTemperature();
+    // =================================================================
+    // Line 3 of OLED Cycle between the sensors in the descriptor table
+    // =================================================================
+    const SENSOR_DESC *s = &sensors[cycle];
 
-      sprintf (msgbuf, "HTU H:%02d.%02d T:%02d.%02d", 
-        (int)htu_humid, (int)(htu_humid*100)%100, 
-        (int)htu_temp, (int)(htu_temp*100)%100);
-    }
-    else {
-      sprintf (msgbuf, "HTU NF"); 
-    } 
-  }
-
-  if (cycle == 5) {   
-    if (VEML7700_exists) {
-      float lux = veml.readLux(VEML_LUX_AUTO);
-      lux = (isnan(lux)) ? 0.0 : lux;
-        sprintf (msgbuf, "LX L%02d.%1d", (int)lux, (int)(lux*10)%10);
-    }
-    else {
-      sprintf (msgbuf, "LX NF");
-    }
-  }
+    if (*s->exists) {
+      float v[SV_MAX];
 
-  if (cycle == 6) {
-    if (SHT_1_exists) {
-      float t = sht1.readTemperature();
-      float h = sht1.readHumidity();
-      sprintf (msgbuf, "SHT1 T:%d.%02d H:%d.%02d", 
-         (int)t, (int)(t*100)%100,
-         (int)h, (int)(h*100)%100);
-    }
-    else {
-      sprintf (msgbuf, "SHT1 NF");
-    }
-  }
-
-  if (cycle == 7) {
-    if (SHT_2_exists) {
-      float t = sht2.readTemperature();
-      float h = sht2.readHumidity();
-      sprintf (msgbuf, "SHT2 T:%d.%02d H:%d.%02d", 
-         (int)t, (int)(t*100)%100,
-         (int)h, (int)(h*100)%100);
-    }
-    else {
-      sprintf (msgbuf, "SHT2 NF");
-    }      
-  }
-
-  if (cycle == 8) {   
-    if (HIH8_exists) {
-      float t = 0.0;
-      float h = 0.0;
-      bool status = hih8_getTempHumid(&t, &h);
-      if (!status) {
-        t = -999.99;
-        h = 0.0;
+      if (s->read == lux_read) {
+        v[0] = lux_last;                // Last search collected by lux_monitor(), not a blocking one
+      }
+      else {
+        sensor_measure(s, v);
+      }
+      fmt_begin(&f, msgbuf, sizeof(msgbuf));
+      fmt_str(&f, s->name);
+      for (int j=0; j<s->nv; j++) {
+        fmt_char(&f, ' ');
+        fmt_float(&f, isnan(v[j]) ? 0.0 : v[j], 1);
       }
-      sprintf (msgbuf, "HIH8 T%d.%02d H%d.%02d", 
-         (int)t, (int)(t*100)%100,
-         (int)h, (int)(h*100)%100);
     }
     else {
-      sprintf (msgbuf, "HIH8 NF");
+      sprintf (msgbuf, "%s NF", s->name);
     }
-  }
+    SM_Line(3, msgbuf);
 
-  if (cycle == 9) {
-    if (SI1145_exists) {
-      float si_vis = uv.readVisible();
-      float si_ir = uv.readIR();
-      float si_uv = uv.readUV()/100.0;
-      sprintf (msgbuf, "SI V%d.%02d I%d.%02d U%d.%02d", 
-        (int)si_vis, (int)(si_vis*100)%100,
-        (int)si_ir, (int)(si_ir*100)%100,
-        (int)si_uv, (int)(si_uv*100)%100);
-    }
-    else {
-      sprintf (msgbuf, "SI NF");
-    }
+    cycle = (cycle + 1) % SENSOR_COUNT;
   }
 
-  len = (strlen (msgbuf) > 21) ? 21 : strlen (msgbuf);
-  for (c=0; c<=len; c++) oled_lines [3][c] = *(msgbuf+c);
-  Serial_writeln (msgbuf);
-
-  cycle = ++cycle % 10;
-  
   OLED_update();
 }
@@ -60,9 +60,54 @@ PRODUCT_VERSION(16);
  *          2025-02-27 RJB Changed distance pin to A4 from A3. 
  *          2025-09-24 RJB Updated deviceOS to 6.3.3
  *
+ *          2026-10-16 RJB Awake time from boot or wake up to sleep is measured and output before sleeping
+ *                         Awake time budget from CONFIG.TXT, health bit SSB_AWAKE set when exceeded
+ *                         Per cycle counts of publishes, bytes published and bytes written to SD
+ *                         Awake time split into phases and by modem state with an estimated mAh per cycle
+ *                         Reported as a "perf" object in SG and/or a daily PERF event, CONFIG.TXT perf=
+ *                         Distance samples are taken by a timer while the network connects, not after
+ *                         Distance median by quickselect instead of a bubble sort, also returns p10/p90
+ *                         Distance sampling stops early on a low MAD, extends when noisy,
+ *                         sample count as "sgn"
+ *                         Optional distance min, max, p10, p90, MAD and outlier count, CONFIG.TXT dg_stats=
+ *                         Optional distance bursts on short wakes while sleeping, CONFIG.TXT dg_burst=
+ *                         Rapid reporting when the distance changes faster than CONFIG.TXT rr_rate=
+ *                         Sensor conversions are started together and collected after one wait
+ *                         BMP3XX driver now waits on the forced conversion before reading the data registers
+ *                         Bosch drivers read all values from one measurement (snapshot)
+ *                         Station Monitor BMX2 was reading sensor 1 temperature and humidity
+ *                         Sensor descriptor table drives discovery, reads, QC, JSON, INFO, Station Monitor
+ *                         I2C_Check_Sensors() bringing BMX2 online used sensor 1 structures,
+ *                         VEML lux was not reported
+ *                         I2C_Check_Sensors() probes each address once, begin() only on change,
+ *                         backoff on failures
+ *                         I2C transactions with a deadline, stuck bus recovery,
+ *                         per address counters in INFO "i2c"
+ *                         BMP3XX compensation done in single precision floats, no software double math
+ *                         BMP280/BME280 forced mode, one conversion per observation,
+ *                         CONFIG.TXT bmx_forced= etc
+ *                         VEML7700 auto lux steps taken while waiting on distance and network,
+ *                         not in one block
+ *                         Station Monitor refreshes at 4Hz with the distance sample and a 5s rolling median
+ *                         Observation is read once into a packed OBS_RECORD,
+ *                         the JSON and display render from it
+ *                         N2S file N2SOBS.DAT holds binary records rendered to JSON when published
+ *                         An N2SOBS.TXT backlog from older firmware is published as SG events, then removed
+ *                         N2S backlog is published as batched SGB events of positional lines,
+ *                         n2s_batch=0 for SG events
+ *                         sg_compact=1 publishes compact SGC events,
+ *                         tools/SGDecode turns SGB and SGC back into SG
+ *                         Fixed point fmt_ formatter replaces sprintf and JSONBufferWriter numbers,
+ *                         fixes -0.50
+ *                         sd_log=1 or 2 writes a binary daily log with a CRC per record,
+ *                         tools/SGLog exports it
+ *                         N2S file is a preallocated ring with head and tail in EEPROM,
+ *                         when full the oldest records are dropped
+ *
  * NOTES:
  * When there is a successful transmission of an observation any need to send obersavations will be sent. 
- * On transmit a failure of these need to send observations, processing is stopped and the file is deleted.
+ * On transmit a failure of these need to send observations, processing is stopped and resumes from
+ * the ring tail next time.
  * 
  * Distance Gauge Calibration
  * Adding serial console jumper after boot will cause distance gauge to be read every 1 second and value printed.
@@ -183,7 +228,7 @@ PRODUCT_VERSION(16);
 #define SSB_SD               0x2   // Set if SD missing at boot or other SD related issues
 #define SSB_RTC              0x4   // Set if RTC missing at boot
 #define SSB_OLED             0x8   // Set if OLED missing at boot, but cleared after first observation
-#define SSB_N2S             0x10   // Set if Need to Send observation file exists
+#define SSB_N2S             0x10   // Set if Need to Send observation ring has records
 #define SSB_FROM_N2S        0x20   // Set if observation is from the Need to Send file
 #define SSB_AS5600          0x40   // Set if wind direction sensor AS5600 has issues - NOT USED with Distance Gauge                   
 #define SSB_BMX_1           0x80   // Set if Barometric Pressure & Altitude Sensor missing
@@ -192,11 +237,13 @@ PRODUCT_VERSION(16);
 #define SSB_SI1145         0x400   // Set if UV index & IR & Visible Sensor missing
 #define SSB_MCP_1          0x800   // Set if Precision I2C Temperature Sensor missing
 #define SSB_MCP_2         0x1000   // Set if Precision I2C Temperature Sensor missing
+#define SSB_AWAKE         0x2000   // Set if the last cycle was awake longer than the awake time budget
 #define SSB_SHT_1         0x4000   // Set if SHTX1 Sensor missing
 #define SSB_SHT_2         0x8000   // Set if SHTX2 Sensor missing
 #define SSB_HIH8         0x10000   // Set if HIH8000 Sensor missing
 #define SSB_LUX          0x20000   // Set if VEML7700 Sensor missing
 #define SSB_PM25AQI      0x40000   // Set if PM25AQI Sensor missing
+#define SSB_RAPID        0x80000   // Set while in rapid reporting, distance changing faster than rr_rate
 
 unsigned int SystemStatusBits = SSB_PWRON; // Set bit 0 for initial value power on. Bit 0 is cleared after first obs
 bool JustPoweredOn = true;         // Used to clear SystemStatusBits set during power on device discovery
@@ -215,7 +262,8 @@ int  LED_PIN = D7;            // Built in LED
 bool PostedResults;           // How we did in posting Observation and Need to Send Observations
 
 uint64_t lastOBS = 0;         // time of next observation
-int countdown = 120;          // Exit station monitor when reaches 0 - protects against burnt out pin or forgotten jumper
+int countdown = 7200;         // Exit station monitor when reaches 0 - protects against burnt out pin or forgotten jumper
+                              // Station monitor passes, 4 a second is 30 minutes
 
 uint64_t NetworkReady = 0;
 uint64_t LastTimeUpdate = 0;
@@ -249,9 +297,10 @@ SdFat SD;                               // File system object.
 File SD_fp;
 char SD_obsdir[] = "/OBS";              // Store our obs in this directory. At Power on, it is created if does not exist
 bool SD_exists = false;                     // Set to true if SD card found at boot
-char SD_n2s_file[] = "N2SOBS.TXT";          // Need To Send Observation file
-uint32_t SD_n2s_max_filesz = 200 * 8 * 24;  // Keep a little over 2 days. When it fills, it is deleted and we start over.
-uint32_t SD_N2S_POSITION = 0;               // Position in the file past observations that have been sent.  
+char SD_n2s_file[] = "N2SOBS.DAT";          // Need To Send Observation ring, binary N2S records
+uint32_t SD_n2s_max_filesz = 200 * 8 * 24;  // Preallocated ring size, about 700 records, 7 days at 15 minutes. When full the oldest records are dropped.
+char SD_n2s_legacy_file[] = "N2SOBS.TXT";   // JSON line backlog from older firmware, published once then removed
+retained uint32_t SD_n2s_legacy_pos = 0;    // Offset in SD_n2s_legacy_file of the next line to publish
 
 char SD_sim_file[] = "SIM.TXT";         // File used to set Ineternal or External sim configuration
 char SD_simold_file[] = "SIMOLD.TXT";   // SIM.TXT renamed to this after sim configuration set
@@ -269,6 +318,7 @@ char SD_INFO_FILE[] = "INFO.TXT";       // Store INFO information in this file.
 #include "SF.h"                   // Support Functions
 #include "OP.h"                   // OutPut support for OLED and Serial Console
 #include "CF.h"                   // Configuration File Variables
+#include "PERF.h"                 // Awake Time Measurement
 #include "TM.h"                   // Time Management
 #include "Sensors.h"              // I2C Based Sensors
 #include "WRD.h"                  // Wind Rain Distance
@@ -282,11 +332,14 @@ char SD_INFO_FILE[] = "INFO.TXT";       // Store INFO information in this file.
 /* 
  *=======================================================================================================================
  * seconds_to_next_obs() - do observations on 0, 15, 30, or 45 minute window
+ *                         In rapid reporting every cf_rr_cadence seconds, which divides the 15 minute window
  *=======================================================================================================================
  */
 int seconds_to_next_obs() {
+  int window = (rr_rapid) ? cf_rr_cadence : 900;
+
   now = rtc.now(); //get the current date-time
-  return (900 - (now.unixtime() % 900)); // 900 = 60s * 15m,  The mod operation gives us seconds passed in this 15m window
+  return (window - (now.unixtime() % window)); // 900 = 60s * 15m,  The mod operation gives us seconds passed in this 15m window
 }
 
 /*
@@ -304,10 +357,12 @@ bool NetworkConnect() {
     if(StartedConnecting == 0) {  // Not already connecting
 #if PLATFORM_ID == PLATFORM_BORON
       Cellular.on();
+      PERF_Modem(true);
       Output ("Cell Connecting");
       Cellular.connect();
 #else
       WiFi.on();
+      PERF_Modem(true);
       Output ("WiFi Connecting");
       WiFi.connect();
 #endif
@@ -360,6 +415,7 @@ void NetworkDisconnect() {
   WiFi.disconnect();
   WiFi.off();
   #endif
+  PERF_Modem(false);
   delay(1000); // in case of race conditions
 
   StartedConnecting = 0;
@@ -401,6 +457,9 @@ SYSTEM_THREAD(ENABLED);
  * ======================================================================================================================
  */
 void setup() {
+  // Start timing the awake part of our first cycle
+  PERF_CycleStart();
+
     // The device has booted, reconnect the battery.
 #if PLATFORM_ID == PLATFORM_BORON
 	pmic.enableBATFET();
@@ -433,15 +492,8 @@ void setup() {
   // Initialize SD card if we have one.
   SD_initialize();
 
-  // Report if we have Need to Send Observations
-  if (SD_exists && SD.exists(SD_n2s_file)) {
-    SystemStatusBits |= SSB_N2S; // Turn on Bit
-    Output("N2S:Exists");
-  }
-  else {
-    SystemStatusBits &= ~SSB_N2S; // Turn Off Bit
-    Output("N2S:NF");
-  }
+  // Read CONFIG.TXT from the SD card, if no file we run with the defaults
+  SD_ReadConfigFile();
 
   // Display EEPROM Information 
   EEPROM_Dump();
@@ -453,6 +505,7 @@ void setup() {
   Output(msgbuf);
 
   // Read RTC and set system clock if RTC clock valid
+  PERF_Phase(PERF_RTC);
   rtc_initialize();
 
   if (Time.isValid()) {
@@ -462,18 +515,26 @@ void setup() {
     Output("STC: Not Valid");
   }
 
+  // N2S ring head and tail, if the clock is not valid yet the first N2S access will do this
+  EEPROM_Initialize();
+
+  // Report if we have Need to Send Observations
+  if (SD_exists && eeprom_valid && eeprom.n2s_count) {
+    SystemStatusBits |= SSB_N2S; // Turn on Bit
+    Output("N2S:Exists");
+  }
+  else {
+    SystemStatusBits &= ~SSB_N2S; // Turn Off Bit
+    Output("N2S:NF");
+  }
+
   stc_timestamp();
   sprintf (msgbuf, "%s=", timestamp);
   Output(msgbuf);
 
   // Adafruit i2c Sensors
-  bmx_initialize();
-  htu21d_initialize();
-  mcp9808_initialize();
-  sht_initialize();
-  hih8_initialize();
-  si1145_initialize();
-  lux_initialize();
+  PERF_Phase(PERF_DISCOVERY);
+  sensors_initialize();
 
   if (SD.exists(SD_5M_DIST_FILE)) {
     dg_adjustment = 1.25;
@@ -484,6 +545,10 @@ void setup() {
     Output ("DIST=10M");
   }
 
+  // Start collecting distance samples while we connect to the network
+  DG_Start();
+  lux_start();
+
 #if PLATFORM_ID == PLATFORM_ARGON
   //==================================================
   // Check if we need to program for WiFi change
@@ -496,6 +561,7 @@ void setup() {
   SimChangeCheck();
 #endif
 
+  PERF_Phase(PERF_CONNECT);
   NetworkConnect();
 }
 
@@ -509,7 +575,7 @@ void loop() {
 
   // If Serial Console Pin LOW then read Distance Gauge, Print and Sleep
   // Used for calibrating Distance Gauge at Installation
-  // Only stay in this mode for countdown seconds, this protects against burnt out pin or forgotten jumper
+  // Only stay in this mode for countdown passes, this protects against burnt out pin or forgotten jumper
   if (countdown && digitalRead(SCE_PIN) == LOW) {
     StationMonitor();
 
@@ -519,16 +585,18 @@ void loop() {
     // StartedConnecting = System.millis();  // Keep set timer so when we pull jumper we finish connecting and not time out
     countdown--;
 
-    // Taking the Distance measurement is delay enough
+    delay (SM_PREVIEW_MS); // Distance sample and display refresh rate
   }
   else { // Normal Operation - Main Work
     if (Time.isValid()) {
       if (Particle.connected()) {
         Output ("Particle Connected");
 
+        PERF_Phase(PERF_PUBLISH);
         if (SendSystemInformation) {
           INFO_Do(); // Function sets SendSystemInformation back to false.
         }
+        PERF_Publish();
 
         OBS_Do();
 
@@ -536,12 +604,14 @@ void loop() {
         JPO_ClearBits();
       
         // STC is automatically updated when the device connects to the Cloud
+        PERF_Phase(PERF_RTC);
         rtc.adjust(DateTime(Time.year(), Time.month(), Time.day(), Time.hour(), Time.minute(), Time.second() ));
         Output("RTC: Updated");
 
         PowerDown = true;
       }
       else {
+        PERF_Phase(PERF_CONNECT);
         bool timedOut = NetworkConnect(); // Check on how we are doing connecting to the Cell Network
 
         if(timedOut == false) { 
@@ -555,6 +625,7 @@ void loop() {
           PowerDown = true;
         }
         else {
+          lux_poll();
           delay (1000); // Waiting on network
         }
       }
@@ -592,6 +663,7 @@ void loop() {
         // Disconnect from the cloud and power down the modem.
         Particle.disconnect();
         Cellular.off();
+        PERF_Modem(false);
         delay(5000);
 
         Output("Powering Down");
@@ -624,32 +696,68 @@ void loop() {
         NetworkConnect();
       }
       else {
+        PERF_Phase(PERF_SLEEP);
         Output ("Going to Sleep");
-        // Disconnect from the cloud and power down the modem.
-        Particle.disconnect();
-        Cellular.off();
+        if (rr_rapid) {
+          // Rapid reporting, leave the modem on. Cellular must not be cycled more than 6 times an hour.
+          Output ("RR:Modem On");
+          PERF_Modem(true); // Sleep is charged with the modem on
+        }
+        else {
+          // Disconnect from the cloud and power down the modem.
+          Particle.disconnect();
+          Cellular.off();
+          PERF_Modem(false);
+        }
 
         OLED_sleepDisplay();
         delay(2000);        
 
+        int sleep_ms = seconds_to_next_obs()*1000;
+        PERF_CycleEnd(sleep_ms);
+
+        // Distance bursts while sleeping, returns with cf_dg_burst seconds or less to the next observation
+        DG_SleepBursts();
+
+        // With the modem left on network activity can wake us early, only observe once the RTC wake is due
+        uint32_t obs_at = rtc.now().unixtime() + seconds_to_next_obs();
         SystemSleepConfiguration config;
         config.mode(SystemSleepMode::ULTRA_LOW_POWER).duration(seconds_to_next_obs()*1000);
+        if (rr_rapid) {
+          config.network(NETWORK_INTERFACE_CELLULAR);
+        }
         SystemSleepResult result = System.sleep(config);
+        while ((result.wakeupReason() != SystemSleepWakeupReason::BY_RTC) && !firmwareUpdateInProgress) {
+          int32_t left = (int32_t) (obs_at - rtc.now().unixtime());
+          if (left <= 0) {
+            break;
+          }
+          Output ("Wake:Not RTC");
+          config.duration(left*1000);
+          result = System.sleep(config);
+        }
 
         // On wake, execution continues after the the System.sleep() command 
         // with all local and global variables intact.
         // System time is still valid.
+        PERF_CycleStart();
        
         OLED_wakeDisplay();
         delay(2000);
         Output("Wake Up");
 
+        // Start collecting distance samples while we connect to the network
+        DG_Start();
+        lux_start();
+
         // Start Network
         StartedConnecting = 0;
         ParticleConnecting = false;
+        PERF_Phase(PERF_CONNECT);
         NetworkConnect();
 
         // See what sensors we have - any go off line while sleeping?
+        PERF_Phase(PERF_DISCOVERY);
         I2C_Check_Sensors();
       } // sleep
     } // powerdown
@@ -662,32 +770,68 @@ void loop() {
         delay (seconds_to_next_obs()*1000);
       }
       else {
+        PERF_Phase(PERF_SLEEP);
         Output ("Going to Sleep");
-        // Disconnect from the cloud and power down the modem.
-        Particle.disconnect();
-        WiFi.off();
+        if (rr_rapid) {
+          // Rapid reporting, leave the modem on
+          Output ("RR:Modem On");
+          PERF_Modem(true); // Sleep is charged with the modem on
+        }
+        else {
+          // Disconnect from the cloud and power down the modem.
+          Particle.disconnect();
+          WiFi.off();
+          PERF_Modem(false);
+        }
 
         OLED_sleepDisplay();
         delay(2000);        
 
+        int sleep_ms = seconds_to_next_obs()*1000;
+        PERF_CycleEnd(sleep_ms);
+
+        // Distance bursts while sleeping, returns with cf_dg_burst seconds or less to the next observation
+        DG_SleepBursts();
+
+        // With the modem left on network activity can wake us early, only observe once the RTC wake is due
+        uint32_t obs_at = rtc.now().unixtime() + seconds_to_next_obs();
         SystemSleepConfiguration config;
         config.mode(SystemSleepMode::ULTRA_LOW_POWER).duration(seconds_to_next_obs()*1000);
+        if (rr_rapid) {
+          config.network(NETWORK_INTERFACE_WIFI_STA);
+        }
         SystemSleepResult result = System.sleep(config);
+        while ((result.wakeupReason() != SystemSleepWakeupReason::BY_RTC) && !firmwareUpdateInProgress) {
+          int32_t left = (int32_t) (obs_at - rtc.now().unixtime());
+          if (left <= 0) {
+            break;
+          }
+          Output ("Wake:Not RTC");
+          config.duration(left*1000);
+          result = System.sleep(config);
+        }
 
         // On wake, execution continues after the the System.sleep() command 
         // with all local and global variables intact.
         // System time is still valid.
+        PERF_CycleStart();
        
         OLED_wakeDisplay();
         delay(2000);
         Output("Wake Up");
 
+        // Start collecting distance samples while we connect to the network
+        DG_Start();
+        lux_start();
+
         // Start Network
         StartedConnecting = 0;
         ParticleConnecting = false;
+        PERF_Phase(PERF_CONNECT);
         NetworkConnect();
 
         // See what sensors we have - any go off line while sleeping?
+        PERF_Phase(PERF_DISCOVERY);
         I2C_Check_Sensors(); // Make sure Sensors are online
       } // sleep
     } // powerdown
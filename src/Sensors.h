@@ -47,6 +47,8 @@ bool BMX_1_exists = false;
 bool BMX_2_exists = false;
 byte BMX_1_type=BMX_TYPE_UNKNOWN;
 byte BMX_2_type=BMX_TYPE_UNKNOWN;
+bool bm31_started = false;          // Conversion started by sensors_start(), collect it
+bool bm32_started = false;
 const char *bmxtype[] = {"UNKN", "BMP280", "BME280", "BMP388", "BMP390"};
 
 /*
@@ -91,6 +93,7 @@ bool SHT_2_exists = false;
  * ======================================================================================================================
  */
 #define HIH8000_ADDRESS   0x27
+#define HIH8_MEAS_MS      40          // Measurement cycle is 36.65ms
 bool HIH8_exists = false;
 
 /*
@@ -113,8 +116,11 @@ float si_last_uv = 0.0;
  * ======================================================================================================================
  */
 #define VEML7700_ADDRESS   0x10
+#define LUX_READ_MAX_MS    5000     // Longest search is 4.3s, 1/8 to 2x gain at 100ms then 200, 400, 800ms integration
 Adafruit_VEML7700 veml = Adafruit_VEML7700();
 bool VEML7700_exists = false;
+bool lux_started = false;           // Auto lux search started by lux_start() and not yet collected
+float lux_last = NAN;               // Lux from the last search collected, shown by the Station Monitor
 
 /* 
  *=======================================================================================================================
@@ -126,80 +132,24 @@ bool VEML7700_exists = false;
  *=======================================================================================================================
  */
 byte get_Bosch_ChipID (byte address) {
-  byte chip_id = 0;
-  byte error;
-
-  Output ("get_Bosch_ChipID()");
-  // The i2c_scanner uses the return value of
-  // the Write.endTransmisstion to see if
-  // a device did acknowledge to the address.
-
   // Important! Need to check the 0x00 register first. Doing a 0x0D (not chip id loaction) on a bmp388 
   // will return a value that could match one of the IDs 
+  const byte reg[] = {0x00, 0xD0};  // BM3 CHIPID REGISTER, BM2 CHIPID REGISTER
+  byte chip_id;
+  byte error;
 
-  // Check Register 0x00
-  sprintf (msgbuf, "  I2C:%02X Reg:%02X", address, 0x00);
-  Output (msgbuf);
-  Wire.begin();
-  Wire.beginTransmission(address);
-  Wire.write(0x00);  // BM3 CHIPID REGISTER
-  error = Wire.endTransmission();
-    //  0:success
-    //  1:data too long to fit in transmit buffer
-    //  2:received NACK on transmit of address
-    //  3:received NACK on transmit of data
-    //  4:other error 
-  if (error) {
-    sprintf (msgbuf, "  ERR_ET:%d", error);
+  Output ("get_Bosch_ChipID()");
+  for (int i=0; i<2; i++) {
+    chip_id = 0;
+    sprintf (msgbuf, "  I2C:%02X Reg:%02X", address, reg[i]);
     Output (msgbuf);
-  }
-  else if (Wire.requestFrom(address, 1)) {  // Returns the number of bytes returned from the slave device 
-    chip_id = Wire.read();
-    if (chip_id == BMP280_CHIP_ID) { // 0x58
-      sprintf (msgbuf, "  CHIPID:%02X BMP280", chip_id);
-      Output (msgbuf);
-      return (chip_id); // Found a Sensor!
-    }
-    else if (chip_id == BMP388_CHIP_ID) {  // 0x50
-      sprintf (msgbuf, "  CHIPID:%02X BMP388", chip_id);
-      Output (msgbuf);
-      return (chip_id); // Found a Sensor!   
-    }
-    else if (chip_id == BME280_BMP390_CHIP_ID) {  // 0x60
-      sprintf (msgbuf, "  CHIPID:%02X BME/390", chip_id);
+
+    error = I2C_Transaction(address, &reg[i], 1, &chip_id, 1);
+    if (error) {
+      sprintf (msgbuf, "  ERR:%d", error);
       Output (msgbuf);
-      return (chip_id); // Found a Sensor!   
     }
-    else {
-      sprintf (msgbuf, "  CHIPID:%02X InValid", chip_id);
-      Output (msgbuf);      
-    }
-  }
-  else {
-    sprintf (msgbuf, "  ERR_RF:0");
-    Output (msgbuf);
-  }
-
-  // Check Register 0xD0
-  chip_id = 0;
-  sprintf (msgbuf, "  I2C:%02X Reg:%02X", address, 0xD0);
-  Output (msgbuf);
-  Wire.begin();
-  Wire.beginTransmission(address);
-  Wire.write(0xD0);  // BM2 CHIPID REGISTER
-  error = Wire.endTransmission();
-    //  0:success
-    //  1:data too long to fit in transmit buffer
-    //  2:received NACK on transmit of address
-    //  3:received NACK on transmit of data
-    //  4:other error 
-  if (error) {
-    sprintf (msgbuf, "  ERR_ET:%d", error);
-    Output (msgbuf);
-  }
-  else if (Wire.requestFrom(address, 1)) {  // Returns the number of bytes returned from the slave device 
-    chip_id = Wire.read(); 
-    if (chip_id == BMP280_CHIP_ID) { // 0x58
+    else if (chip_id == BMP280_CHIP_ID) { // 0x58
       sprintf (msgbuf, "  CHIPID:%02X BMP280", chip_id);
       Output (msgbuf);
       return (chip_id); // Found a Sensor!
@@ -216,253 +166,201 @@ byte get_Bosch_ChipID (byte address) {
     }
     else {
       sprintf (msgbuf, "  CHIPID:%02X InValid", chip_id);
-      Output (msgbuf);   
+      Output (msgbuf);      
     }
   }
-  else {
-    sprintf (msgbuf, "  ERR_RF:0");
-    Output (msgbuf);
-  }
   return(0);
 }
 
 /* 
  *=======================================================================================================================
- * bmx_initialize() - Bosch sensor initialize
+ * bmx_bm3() - Does this Bosch sensor use the BMP3XX driver
  *=======================================================================================================================
  */
-void bmx_initialize() {
-  Output("BMX:INIT");
-  
-  // 1st Bosch Sensor - Need to see which (BMP, BME, BM3) is plugged in
-  BMX_1_chip_id = get_Bosch_ChipID(BMX_ADDRESS_1);
-
-  switch (BMX_1_chip_id) {
-    case BMP280_CHIP_ID :
-      if (!bmp1.begin(BMX_ADDRESS_1)) { 
-        msgp = (char *) "BMP1 ERR";
-        BMX_1_exists = false;
-        SystemStatusBits |= SSB_BMX_1;  // Turn On Bit          
-      }
-      else {
-        BMX_1_exists = true;
-        BMX_1_type = BMX_TYPE_BMP280;
-        msgp = (char *) "BMP1 OK";
-        float p = bmp1.readPressure();
-      }
-    break;
-
-    case BME280_BMP390_CHIP_ID :
-      if (!bme1.begin(BMX_ADDRESS_1)) { 
-        if (!bm31.begin_I2C(BMX_ADDRESS_1)) {  // Perhaps it is a BMP390
-          msgp = (char *) "BMX1 ERR";
-          BMX_1_exists = false;
-          SystemStatusBits |= SSB_BMX_1;  // Turn On Bit          
-        }
-        else {
-          BMX_1_exists = true;
-          BMX_1_type = BMX_TYPE_BMP390;
-          msgp = (char *) "BMP390_1 OK"; 
-          float p = bm31.readPressure();       
-        }      
-      }
-      else {
-        BMX_1_exists = true;
-        BMX_1_type = BMX_TYPE_BME280;
-        msgp = (char *) "BME280_1 OK";
-        float p = bme1.readPressure();
-      }
-    break;
-
-    case BMP388_CHIP_ID :
-      if (!bm31.begin_I2C(BMX_ADDRESS_1)) { 
-        msgp = (char *) "BM31 ERR";
-        BMX_1_exists = false;
-        SystemStatusBits |= SSB_BMX_1;  // Turn On Bit          
-      }
-      else {
-        BMX_1_exists = true;
-        BMX_1_type = BMX_TYPE_BMP388;
-        msgp = (char *) "BM31 OK";
-        float p = bm31.readPressure();
-      }
-    break;
-
-    default:
-      msgp = (char *) "BMX_1 NF";
-    break;
+bool bmx_bm3(byte chip_id, byte type) {
+  if (chip_id == BMP280_CHIP_ID) {
+    return (false);
   }
-  Output (msgp);
-
-  // 2nd Bosch Sensor - Need to see which (BMP, BME, BM3) is plugged in
-  BMX_2_chip_id = get_Bosch_ChipID(BMX_ADDRESS_2);
-  switch (BMX_2_chip_id) {
-    case BMP280_CHIP_ID :
-      if (!bmp2.begin(BMX_ADDRESS_2)) { 
-        msgp = (char *) "BMP2 ERR";
-        BMX_2_exists = false;
-        SystemStatusBits |= SSB_BMX_2;  // Turn On Bit          
-      }
-      else {
-        BMX_2_exists = true;
-        BMX_2_type = BMX_TYPE_BMP280;
-        msgp = (char *) "BMP2 OK";
-        float p = bmp2.readPressure();
-      }
-    break;
-
-    case BME280_BMP390_CHIP_ID :
-      if (!bme2.begin(BMX_ADDRESS_2)) { 
-        if (!bm32.begin_I2C(BMX_ADDRESS_2)) {  // Perhaps it is a BMP390
-          msgp = (char *) "BMX2 ERR";
-          BMX_2_exists = false;
-          SystemStatusBits |= SSB_BMX_2;  // Turn On Bit          
-        }
-        else {
-          BMX_2_exists = true;
-          BMX_2_type = BMX_TYPE_BMP390;
-          msgp = (char *) "BMP390_2 OK"; 
-          float p = bm32.readPressure();         
-        }
-      }
-      else {
-        BMX_2_exists = true;
-        BMX_2_type = BMX_TYPE_BME280;
-        msgp = (char *) "BME280_2 OK";
-        float p = bme2.readPressure();
-      }
-    break;
-
-    case BMP388_CHIP_ID :
-      if (!bm32.begin_I2C(BMX_ADDRESS_2)) { 
-        msgp = (char *) "BM32 ERR";
-        BMX_2_exists = false;
-        SystemStatusBits |= SSB_BMX_2;  // Turn On Bit          
-      }
-      else {
-        BMX_2_exists = true;
-        BMX_2_type = BMX_TYPE_BMP388;
-        msgp = (char *) "BM32 OK";
-        float p = bm32.readPressure();
-      }
-    break;
-
-    default:
-      msgp = (char *) "BMX_2 NF";
-    break;
+  if (chip_id == BME280_BMP390_CHIP_ID) {
+    return (type == BMX_TYPE_BMP390);
   }
-  Output (msgp);
+  return (true); // BMP388
 }
 
 /* 
  *=======================================================================================================================
- * htu21d_initialize() - HTU21D sensor initialize
+ * bmx_read() - One measurement from Bosch sensor 1 or 2, pressure in hPa
+ * 
+ *  Each driver's snapshot() reads every value from the same measurement. Values not read are NAN, humidity
+ *  is 0.0 for sensors without it.
  *=======================================================================================================================
  */
-void htu21d_initialize() {
-  Output("HTU21D:INIT");
-  
-  // HTU21DF Humidity & Temp Sensor (I2C ADDRESS = 0x40)
-  if (!htu.begin()) {
-    msgp = (char *) "HTU NF";
-    HTU21DF_exists = false;
-    SystemStatusBits |= SSB_HTU21DF;  // Turn On Bit
+void bmx_read(int n, float *p, float *t, float *h) {
+  byte chip_id = (n == 1) ? BMX_1_chip_id : BMX_2_chip_id;
+  byte type    = (n == 1) ? BMX_1_type : BMX_2_type;
+
+  *p = NAN;
+  *t = NAN;
+  *h = 0.0;
+
+  if (chip_id == BMP280_CHIP_ID) {
+    bmp280_snapshot_t s;
+    if (((n == 1) ? bmp1 : bmp2).snapshot(&s)) {
+      *p = s.pressure/100.0F;
+      *t = s.temperature;
+    }
   }
-  else {
-    HTU21DF_exists = true;
-    msgp = (char *) "HTU OK";
+  else if (bmx_bm3(chip_id, type)) {
+    Adafruit_BMP3XX &bm3 = (n == 1) ? bm31 : bm32;
+    bool &started = (n == 1) ? bm31_started : bm32_started;
+    bmp3xx_snapshot_t s;
+    bool ok;
+
+    if (started) {
+      // Conversion was started by sensors_start(), just collect it
+      started = false;
+      ok = bm3.collectReading();
+      s.pressure = bm3.pressure;
+      s.temperature = bm3.temperature;
+    }
+    else {
+      ok = bm3.snapshot(&s);
+    }
+    if (ok) {
+      *p = s.pressure/100.0F;
+      *t = s.temperature;
+    }
+  }
+  else if (type == BMX_TYPE_BME280) {
+    bme280_snapshot_t s;
+    if (((n == 1) ? bme1 : bme2).snapshot(&s)) {
+      *p = s.pressure/100.0F;
+      *t = s.temperature;
+      *h = s.humidity;
+    }
   }
-  Output (msgp);
 }
 
 /* 
  *=======================================================================================================================
- * mcp9808_initialize() - MCP9808 sensor initialize
+ * bmx_osrs() - Oversampling count 1,2,4,8,16 or IIR filter coefficient 2,4,8,16 to the register code, 0 is off
  *=======================================================================================================================
  */
-void mcp9808_initialize() {
-  Output("MCP9808:INIT");
-  
-  // 1st MCP9808 Precision I2C Temperature Sensor (I2C ADDRESS = 0x18)
-  mcp1 = Adafruit_MCP9808();
-  if (!mcp1.begin(MCP_ADDRESS_1)) {
-    msgp = (char *) "MCP1 NF";
-    MCP_1_exists = false;
-    SystemStatusBits |= SSB_MCP_1;  // Turn On Bit
+int bmx_osrs(int n, bool filter) {
+  int code = 0;
+
+  while ((n > 1) && (code < 4)) {
+    n >>= 1;
+    code++;
   }
-  else {
-    MCP_1_exists = true;
-    msgp = (char *) "MCP1 OK";
+  if (filter) {
+    return (code);      // 2=1 ... 16=4
   }
-  Output (msgp);
+  return ((n) ? code+1 : 0);  // 1=1 ... 16=5
+}
 
-  // 2nd MCP9808 Precision I2C Temperature Sensor (I2C ADDRESS = 0x19)
-  mcp2 = Adafruit_MCP9808();
-  if (!mcp2.begin(MCP_ADDRESS_2)) {
-    msgp = (char *) "MCP2 NF";
-    MCP_2_exists = false;
-    SystemStatusBits |= SSB_MCP_2;  // Turn On Bit
+/* 
+ *=======================================================================================================================
+ * bmx_forced() - Put a BMP280 or BME280 in forced mode, it sleeps until bmx_start() asks for a conversion
+ *=======================================================================================================================
+ */
+void bmx_forced(int n) {
+  byte chip_id = (n == 1) ? BMX_1_chip_id : BMX_2_chip_id;
+  byte type    = (n == 1) ? BMX_1_type : BMX_2_type;
+
+  if (chip_id == BMP280_CHIP_ID) {
+    ((n == 1) ? bmp1 : bmp2).setSampling(Adafruit_BMP280::MODE_FORCED,
+      (Adafruit_BMP280::sensor_sampling) bmx_osrs(cf_bmx_osrs_t, false),
+      (Adafruit_BMP280::sensor_sampling) bmx_osrs(cf_bmx_osrs_p, false),
+      (Adafruit_BMP280::sensor_filter) bmx_osrs(cf_bmx_filter, true));
   }
-  else {
-    MCP_2_exists = true;
-    msgp = (char *) "MCP2 OK";
+  else if (type == BMX_TYPE_BME280) {
+    ((n == 1) ? bme1 : bme2).setSampling(Adafruit_BME280::MODE_FORCED,
+      (Adafruit_BME280::sensor_sampling) bmx_osrs(cf_bmx_osrs_t, false),
+      (Adafruit_BME280::sensor_sampling) bmx_osrs(cf_bmx_osrs_p, false),
+      (Adafruit_BME280::sensor_sampling) bmx_osrs(cf_bmx_osrs_h, false),
+      (Adafruit_BME280::sensor_filter) bmx_osrs(cf_bmx_filter, true));
   }
-  Output (msgp);
 }
 
 /* 
  *=======================================================================================================================
- * sht_initialize() - SHT31 sensor initialize
+ * bmx_begin() - Bring Bosch sensor 1 or 2 online, need to see which (BMP, BME, BM3) is plugged in
  *=======================================================================================================================
  */
-void sht_initialize() {
-  Output("SHT:INIT");
-  
-  // 1st SHT31 I2C Temperature/Humidity Sensor (I2C ADDRESS = 0x44)
-  sht1 = Adafruit_SHT31();
-  if (!sht1.begin(SHT_ADDRESS_1)) {
-    msgp = (char *) "SHT1 NF";
-    SHT_1_exists = false;
-    SystemStatusBits |= SSB_SHT_1;  // Turn On Bit
-  }
-  else {
-    SHT_1_exists = true;
-    msgp = (char *) "SHT1 OK";
+bool bmx_begin(int n) {
+  byte address  = (n == 1) ? BMX_ADDRESS_1 : BMX_ADDRESS_2;
+  byte &chip_id = (n == 1) ? BMX_1_chip_id : BMX_2_chip_id;
+  byte &type    = (n == 1) ? BMX_1_type : BMX_2_type;
+  bool ok = false;
+
+  chip_id = get_Bosch_ChipID(address);
+  switch (chip_id) {
+    case BMP280_CHIP_ID :
+      ok = ((n == 1) ? bmp1 : bmp2).begin(address);
+      type = BMX_TYPE_BMP280;
+    break;
+
+    case BME280_BMP390_CHIP_ID :
+      ok = ((n == 1) ? bme1 : bme2).begin(address);
+      type = BMX_TYPE_BME280;
+      if (!ok) {  // Perhaps it is a BMP390
+        ok = ((n == 1) ? bm31 : bm32).begin_I2C(address);
+        type = BMX_TYPE_BMP390;
+      }
+    break;
+
+    case BMP388_CHIP_ID :
+      ok = ((n == 1) ? bm31 : bm32).begin_I2C(address);
+      type = BMX_TYPE_BMP388;
+    break;
+
+    default:
+    break;
   }
-  Output (msgp);
 
-  // 2nd SHT31 I2C Temperature/Humidity Sensor (I2C ADDRESS = 0x45)
-  sht2 = Adafruit_SHT31();
-  if (!sht2.begin(SHT_ADDRESS_2)) {
-    msgp = (char *) "SHT2 NF";
-    SHT_2_exists = false;
-    SystemStatusBits |= SSB_SHT_2;  // Turn On Bit
+  if (ok) {
+    float p, t, h;
+    if (cf_bmx_forced) {
+      bmx_forced(n);
+    }
+    bmx_read(n, &p, &t, &h); // First pressure reading after begin is bad
   }
   else {
-    SHT_2_exists = true;
-    msgp = (char *) "SHT2 OK";
+    type = BMX_TYPE_UNKNOWN;
   }
-  Output (msgp);
+  return (ok);
 }
 
 /* 
  *=======================================================================================================================
- * hih8_initialize() - HIH8000 sensor initialize
+ * bmx_start() - Start a conversion on Bosch sensor 1 or 2, returns ms until it is done, 0 if none was started
+ * 
+ *  The BMP388/390 always converts on request. The BMP280/BME280 do when in forced mode, otherwise they are
+ *  converting continuously and are read directly.
  *=======================================================================================================================
  */
-void hih8_initialize() {
-  Output("HIH8:INIT");
-
-  if (I2C_Device_Exist(HIH8000_ADDRESS)) {
-    HIH8_exists = true;
-    msgp = (char *) "HIH8 OK";
+uint32_t bmx_start(int n) {
+  byte chip_id = (n == 1) ? BMX_1_chip_id : BMX_2_chip_id;
+  byte type    = (n == 1) ? BMX_1_type : BMX_2_type;
+  bool &started = (n == 1) ? bm31_started : bm32_started;
+  uint32_t us = 0;
+
+  started = false;
+  if (bmx_bm3(chip_id, type)) {
+    Adafruit_BMP3XX &bm3 = (n == 1) ? bm31 : bm32;
+    started = bm3.startConversion();
+    us = (started) ? bm3.conversionTime() : 0;
   }
-  else {
-    msgp = (char *) "HIH8 NF";
-    HIH8_exists = false;
-    SystemStatusBits |= SSB_HIH8;  // Turn On Bit
+  else if (chip_id == BMP280_CHIP_ID) {
+    Adafruit_BMP280 &bmp = (n == 1) ? bmp1 : bmp2;
+    us = (bmp.startForcedMeasurement()) ? bmp.measurementTime() : 0;
   }
-  Output (msgp);
+  else if (type == BMX_TYPE_BME280) {
+    Adafruit_BME280 &bme = (n == 1) ? bme1 : bme2;
+    us = (bme.startForcedMeasurement()) ? bme.measurementTime() : 0;
+  }
+  return ((us+999)/1000);
 }
 
 /* 
@@ -475,30 +373,18 @@ bool hih8_getTempHumid(float *t, float *h) {
   if (HIH8_exists) {
     uint16_t humidityBuffer    = 0;
     uint16_t temperatureBuffer = 0;
-  
-    Wire.begin();
-    Wire.beginTransmission(HIH8000_ADDRESS);
-
-    Wire.write(0x00); // set the register location for read request
-
-    delayMicroseconds(200); // give some time for sensor to process request
+    byte data[4];
 
-    if (Wire.requestFrom(HIH8000_ADDRESS, 4) == 4) {
+    if (I2C_Transaction(HIH8000_ADDRESS, NULL, 0, data, 4) == 0) {
 
       // Get raw humidity data
-      humidityBuffer = Wire.read();
-      humidityBuffer <<= 8;
-      humidityBuffer |= Wire.read();
+      humidityBuffer = (data[0] << 8) | data[1];
       humidityBuffer &= 0x3FFF;   // 14bit value, get rid of the upper 2 status bits
 
       // Get raw temperature data
-      temperatureBuffer = Wire.read();
-      temperatureBuffer <<= 8;
-      temperatureBuffer |= Wire.read();
+      temperatureBuffer = (data[2] << 8) | data[3];
       temperatureBuffer >>= 2;  // Remove the last two "Do Not Care" bits (shift left is same as divide by 4)
 
-      Wire.endTransmission();
-
       *h = humidityBuffer * 6.10e-3;
       *t = temperatureBuffer * 1.007e-2 - 40.0;
 
@@ -508,7 +394,6 @@ bool hih8_getTempHumid(float *t, float *h) {
       return (true);
     }
     else {
-      Wire.endTransmission();
       return(false);
     }
   }
@@ -519,37 +404,189 @@ bool hih8_getTempHumid(float *t, float *h) {
 
 /* 
  *=======================================================================================================================
- * si1145_initialize() - SI1145 sensor initialize
+ * hih8_startMeasurement() - Send a Measurement Request, data is ready to read after HIH8_MEAS_MS
+ *=======================================================================================================================
+ */
+bool hih8_startMeasurement() {
+  return (I2C_Transaction(HIH8000_ADDRESS, NULL, 0, NULL, 0) == 0);
+}
+
+/*
+ * ======================================================================================================================
+ *  Two Phase Sensor Reads
+ * 
+ *  Sensors that do a conversion on request (BMP388/390, BMP280/BME280 in forced mode, SHT31, HTU21DF, HIH8000) are
+ *  all started by sensors_start() and OBS_Do() waits once, sensors_wait(), for the slowest before collecting. The
+ *  sensor phase then takes about as long as the slowest conversion instead of the sum of them. MCP9808 and SI1145
+ *  convert continuously and are read directly.
+ * 
+ *  The HTU21DF converts one value at a time. Its humidity conversion is started when the temperature is
+ *  collected and runs while the other sensors are read.
+ * ======================================================================================================================
+ */
+uint64_t sensors_ready = 0;             // System.millis() when all started conversions are done
+bool sht1_started = false;
+bool sht2_started = false;
+bool htu_started = false;
+bool hih8_started = false;
+
+/* 
+ *=======================================================================================================================
+ * sensors_ready_in() - A conversion was started that will be done in ms
  *=======================================================================================================================
  */
-void si1145_initialize() {
-  Output("SI1145:INIT");
-  
-  // SSB_SI1145 UV index & IR & Visible Sensor (I2C ADDRESS = 0x60)
-  if (! uv.begin(&Wire)) {
-    Output ("SI:NF");
-    SI1145_exists = false;
-    SystemStatusBits |= SSB_SI1145;  // Turn On Bit
+void sensors_ready_in(uint32_t ms) {
+  uint64_t t = System.millis() + ms;
+
+  if (t > sensors_ready) {
+    sensors_ready = t;
   }
-  else {
-    SI1145_exists = true;
-    Output ("SI:OK");
-    si_last_vis = uv.readVisible();
-    si_last_ir = uv.readIR();
-    si_last_uv = uv.readUV()/100.0;
+}
 
-    sprintf (msgbuf, "SI:VI[%d.%02d]", (int)si_last_vis, (int)(si_last_vis*100.0)%100); 
-    Output (msgbuf);
-    sprintf (msgbuf, "SI:IR[%d.%02d]", (int)si_last_ir, (int)(si_last_ir*100.0)%100); 
-    Output (msgbuf);
-    sprintf (msgbuf, "SI:UV[%d.%02d]", (int)si_last_uv, (int)(si_last_uv*100.0)%100); 
-    Output (msgbuf);
+/* 
+ *=======================================================================================================================
+ * sensors_wait() - Wait on the started conversions to be done
+ *=======================================================================================================================
+ */
+void sensors_wait() {
+  uint64_t t = System.millis();
+
+  if (sensors_ready > t) {
+    delay(sensors_ready - t);
+  }
+}
+
+/*
+ * ======================================================================================================================
+ *  Sensor Hooks - Called through the sensor descriptor table
+ * 
+ *  begin()  - Bring the sensor online, true if found
+ *  start()  - Start a conversion, returns ms until it is done, 0 if nothing was started
+ *  read()   - Read the sensor or collect the started conversion into v[], values not read are NAN
+ *  finish() - Collect values that needed a second conversion, called after sensors_wait()
+ * ======================================================================================================================
+ */
+bool bmx1_begin() { return (bmx_begin(1)); }
+bool bmx2_begin() { return (bmx_begin(2)); }
+
+uint32_t bmx1_start() { return (bmx_start(1)); }
+uint32_t bmx2_start() { return (bmx_start(2)); }
+
+bool bmx1_read(float v[]) { bmx_read(1, &v[0], &v[1], &v[2]); return (true); } // hPa, C, %
+bool bmx2_read(float v[]) { bmx_read(2, &v[0], &v[1], &v[2]); return (true); }
+
+bool htu_begin() { return (htu.begin()); }
+
+uint32_t htu_start() {
+  htu_started = htu.startTemperature();
+  return ((htu_started) ? HTU21DF_MEAS_MS : 0);
+}
+
+bool htu_read(float v[]) {
+  v[0] = (htu_started) ? htu.collectTemperature() : NAN;
+  v[1] = NAN;
+
+  // Humidity converts while we read the other sensors
+  htu_started = htu.startHumidity();
+  if (htu_started) {
+    sensors_ready_in(HTU21DF_MEAS_MS);
+  }
+  return (true);
+}
+
+bool htu_finish(float v[]) {
+  v[1] = (htu_started) ? htu.collectHumidity() : NAN;
+  htu_started = false;
+  return (true);
+}
+
+bool mcp1_begin() { return (mcp1.begin(MCP_ADDRESS_1)); }
+bool mcp2_begin() { return (mcp2.begin(MCP_ADDRESS_2)); }
+bool mcp1_read(float v[]) { v[0] = mcp1.readTempC(); return (true); }
+bool mcp2_read(float v[]) { v[0] = mcp2.readTempC(); return (true); }
+
+bool sht1_begin() { return (sht1.begin(SHT_ADDRESS_1)); }
+bool sht2_begin() { return (sht2.begin(SHT_ADDRESS_2)); }
+
+uint32_t sht1_start() {
+  sht1_started = sht1.startMeasurement();
+  return ((sht1_started) ? SHT31_MEAS_MS : 0);
+}
+
+uint32_t sht2_start() {
+  sht2_started = sht2.startMeasurement();
+  return ((sht2_started) ? SHT31_MEAS_MS : 0);
+}
+
+bool sht1_read(float v[]) {
+  bool ok = sht1_started && sht1.readMeasurement(&v[0], &v[1]);
+  sht1_started = false;
+  return (ok);
+}
+
+bool sht2_read(float v[]) {
+  bool ok = sht2_started && sht2.readMeasurement(&v[0], &v[1]);
+  sht2_started = false;
+  return (ok);
+}
+
+bool hih8_begin() { return (I2C_Device_Exist(HIH8000_ADDRESS)); }
+
+uint32_t hih8_start() {
+  hih8_started = hih8_startMeasurement();
+  return ((hih8_started) ? HIH8_MEAS_MS : 0);
+}
+
+bool hih8_read(float v[]) {
+  hih8_started = false;
+  return (hih8_getTempHumid(&v[0], &v[1]));
+}
+
+bool si1145_begin() {
+  if (!uv.begin(&Wire)) {
+    return (false);
   }
+  si_last_vis = uv.readVisible();
+  si_last_ir = uv.readIR();
+  si_last_uv = uv.readUV()/100.0;
+  return (true);
+}
+
+bool si1145_read(float v[]) {
+  v[0] = uv.readVisible();
+  v[1] = uv.readIR();
+  v[2] = uv.readUV()/100.0;
+
+  // Additional code to force sensor online if we are getting 0.0s back.
+  if ( ((v[0]+v[1]+v[2]) == 0.0) && ((si_last_vis+si_last_ir+si_last_uv) != 0.0) ) {
+    // Let Reset The SI1145 and try again
+    Output ("SI RESET");
+    if (uv.begin()) {
+      SI1145_exists = true;
+      Output ("SI ONLINE");
+      SystemStatusBits &= ~SSB_SI1145; // Turn Off Bit
+
+      v[0] = uv.readVisible();
+      v[1] = uv.readIR();
+      v[2] = uv.readUV()/100.0;
+    }
+    else {
+      SI1145_exists = false;
+      Output ("SI OFFLINE");
+      SystemStatusBits |= SSB_SI1145;  // Turn On Bit    
+    }
+  }
+
+  // Save current readings for next loop around compare
+  si_last_vis = v[0];
+  si_last_ir = v[1];
+  si_last_uv = v[2];
+  return (true);
 }
 
 /* 
  *=======================================================================================================================
- * lux_initialize() - VEML7700 sensor initialize
+ * lux_begin() - VEML7700 sensor
  * 
  * SEE https://learn.microsoft.com/en-us/windows/win32/sensorsapi/understanding-and-interpreting-lux-values
  * 
@@ -578,17 +615,257 @@ void si1145_initialize() {
  * 
  *=======================================================================================================================
  */
-void lux_initialize() {
-  Output("LUX:INIT");
+bool lux_begin() { return (veml.begin()); }
 
-  if (veml.begin()) {
-    VEML7700_exists = true;
-    msgp = (char *) "LUX OK";
+/* 
+ *=======================================================================================================================
+ * lux_start() - Start the VEML7700 auto gain and integration time search, called at wake
+ * 
+ *  Each step of the search waits on up to two integration times, which can add up to over a second. The steps
+ *  are taken by lux_poll() while we wait on the distance samples and the network, lux_read() collects it.
+ *=======================================================================================================================
+ */
+void lux_start() {
+  if (VEML7700_exists) {
+    veml.autoLuxStart();
+    lux_started = true;
   }
-  else {
-    msgp = (char *) "LUX NF";
-    VEML7700_exists = false;
-    SystemStatusBits |= SSB_LUX;  // Turn On Bit
+}
+
+/* 
+ *=======================================================================================================================
+ * lux_poll() - Take the next step of the VEML7700 search if its integration is done, never waits
+ *=======================================================================================================================
+ */
+void lux_poll() {
+  if (VEML7700_exists && lux_started) {
+    veml.autoLuxPoll();
+  }
+}
+
+/* 
+ *=======================================================================================================================
+ * lux_read() - Collect the VEML7700 search, finishing what was not done while we waited on other work
+ * 
+ *  The wait is capped at LUX_READ_MAX_MS, a sensor that stops answering mid search would otherwise hold us
+ *  awake. The search is dropped and false returned, the next read starts a new one.
+ *=======================================================================================================================
+ */
+bool lux_read(float v[]) {
+  uint64_t start = System.millis();
+
+  if (!lux_started) {
+    veml.autoLuxStart();
+  }
+  lux_started = false;
+  while (!veml.autoLuxPoll()) {
+    if ((System.millis() - start) >= LUX_READ_MAX_MS) {
+      Output ("LUX:Search Timeout");
+      return (false);
+    }
+    delay(veml.autoLuxReadyIn());
+  }
+  v[0] = lux_last = veml.autoLuxResult();
+  return (true);
+}
+
+/* 
+ *=======================================================================================================================
+ * lux_monitor() - Keep a VEML7700 search running for the Station Monitor, never waits
+ * 
+ *  Called every Station Monitor pass. Takes the next step of the search and starts another when one finishes,
+ *  lux_last has the result. A fresh search on each refresh would block the 4Hz display for over 4 seconds.
+ *=======================================================================================================================
+ */
+void lux_monitor() {
+  if (!VEML7700_exists) {
+    return;
+  }
+  if (!lux_started) {
+    lux_start();
+  }
+  else if (veml.autoLuxPoll()) {
+    lux_last = veml.autoLuxResult();
+    veml.autoLuxStart();
+  }
+}
+
+/*
+ * ======================================================================================================================
+ *  Sensor Descriptor Table
+ * 
+ *  One entry per I2C sensor. Discovery, the online/offline checks, the observation reads, QC, the JSON keys,
+ *  INFO, the Station Monitor and the not found health bits all iterate this table. Adding a sensor (the
+ *  PM25AQI already has SSB_PM25AQI reserved) is writing its hooks and adding an entry here.
+ * 
+ *  The order of the entries is the order of the observation JSON keys.
+ * ======================================================================================================================
+ */
+#define SV_MAX    3   // Most values from one sensor
+
+typedef struct {
+  const char *name;                   // Output, INFO and Station Monitor label
+  byte address;                       // I2C address checked by I2C_Check_Sensors()
+  unsigned int ssb;                   // SystemStatusBits bit set when the sensor is missing
+  bool *exists;                       // Sensor is online
+  byte *type;                         // BMX type reported by INFO, NULL for others
+  bool (*begin)();
+  uint32_t (*start)();                // NULL for sensors that convert continuously
+  bool (*read)(float v[]);
+  bool (*finish)(float v[]);          // NULL for sensors read in one phase
+  byte nv;                            // Number of values
+  const char *key[SV_MAX];            // Observation JSON key of each value
+  byte qc[SV_MAX];                    // qc_range[] index of each value
+  byte precision[SV_MAX];             // Observation JSON decimal places of each value
+} SENSOR_DESC;
+
+constexpr SENSOR_DESC sensors[] = {
+  {"BMX1", BMX_ADDRESS_1,    SSB_BMX_1,   &BMX_1_exists,    &BMX_1_type, bmx1_begin,   bmx1_start, bmx1_read,   NULL,
+    3, {"bp1", "bt1", "bh1"}, {QC_P, QC_T, QC_RH},   {4, 2, 2}},
+  {"BMX2", BMX_ADDRESS_2,    SSB_BMX_2,   &BMX_2_exists,    &BMX_2_type, bmx2_begin,   bmx2_start, bmx2_read,   NULL,
+    3, {"bp2", "bt2", "bh2"}, {QC_P, QC_T, QC_RH},   {4, 2, 2}},
+  {"HTU",  HTU21DF_I2CADDR,  SSB_HTU21DF, &HTU21DF_exists,  NULL,        htu_begin,    htu_start,  htu_read,    htu_finish,
+    2, {"ht1", "hh1"},        {QC_T, QC_RH},         {2, 2}},
+  {"MCP1", MCP_ADDRESS_1,    SSB_MCP_1,   &MCP_1_exists,    NULL,        mcp1_begin,   NULL,       mcp1_read,   NULL,
+    1, {"mt1"},               {QC_T},                {2}},
+  {"MCP2", MCP_ADDRESS_2,    SSB_MCP_2,   &MCP_2_exists,    NULL,        mcp2_begin,   NULL,       mcp2_read,   NULL,
+    1, {"mt2"},               {QC_T},                {2}},
+  {"SHT1", SHT_ADDRESS_1,    SSB_SHT_1,   &SHT_1_exists,    NULL,        sht1_begin,   sht1_start, sht1_read,   NULL,
+    2, {"st1", "sh1"},        {QC_T, QC_RH},         {2, 2}},
+  {"SHT2", SHT_ADDRESS_2,    SSB_SHT_2,   &SHT_2_exists,    NULL,        sht2_begin,   sht2_start, sht2_read,   NULL,
+    2, {"st2", "sh2"},        {QC_T, QC_RH},         {2, 2}},
+  {"HIH8", HIH8000_ADDRESS,  SSB_HIH8,    &HIH8_exists,     NULL,        hih8_begin,   hih8_start, hih8_read,   NULL,
+    2, {"ht2", "hh2"},        {QC_T, QC_RH},         {2, 2}},
+  {"SI",   SI1145_ADDR,      SSB_SI1145,  &SI1145_exists,   NULL,        si1145_begin, NULL,       si1145_read, NULL,
+    3, {"sv1", "si1", "su1"}, {QC_VI, QC_IR, QC_UV}, {2, 2, 2}},
+  {"VEML", VEML7700_ADDRESS, SSB_LUX,     &VEML7700_exists, NULL,        lux_begin,    NULL,       lux_read,    NULL,
+    1, {"lx"},                {QC_LX},               {2}},
+};
+#define SENSOR_COUNT  (sizeof(sensors)/sizeof(sensors[0]))
+
+/* 
+ *=======================================================================================================================
+ * sensors_ssb_mask() - All the sensor not found bits
+ *=======================================================================================================================
+ */
+unsigned int sensors_ssb_mask() {
+  unsigned int mask = 0;
+
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    mask |= sensors[i].ssb;
+  }
+  return (mask);
+}
+
+/* 
+ *=======================================================================================================================
+ * sensors_initialize() - Discover the I2C sensors at boot
+ *=======================================================================================================================
+ */
+void sensors_initialize() {
+  Output("SENSORS:INIT");
+
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    const SENSOR_DESC *s = &sensors[i];
+
+    *s->exists = s->begin();
+    if (*s->exists) {
+      sprintf (Buffer32Bytes, "%s OK", s->name);
+    }
+    else {
+      sprintf (Buffer32Bytes, "%s NF", s->name);
+      SystemStatusBits |= s->ssb;  // Turn On Bit
+    }
+    Output (Buffer32Bytes);
+  }
+}
+
+/* 
+ *=======================================================================================================================
+ * sensors_start() - Start a conversion on each sensor that needs one
+ *=======================================================================================================================
+ */
+void sensors_start() {
+  sensors_ready = System.millis();
+
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    if (*sensors[i].exists && sensors[i].start) {
+      sensors_ready_in(sensors[i].start());
+    }
   }
-  Output (msgp);
-}
\ No newline at end of file
+}
+
+/* 
+ *=======================================================================================================================
+ * sensors_qc() - Replace values that are NAN or out of range with the error value
+ *=======================================================================================================================
+ */
+void sensors_qc(const SENSOR_DESC *s, float v[]) {
+  for (int j=0; j<s->nv; j++) {
+    const QC_RANGE *q = &qc_range[s->qc[j]];
+    v[j] = (isnan(v[j]) || (v[j] < q->min) || (v[j] > q->max)) ? q->err : v[j];
+  }
+}
+
+/* 
+ *=======================================================================================================================
+ * sensors_observe() - One measurement from every sensor online, QC'd values in sv[], 0.0 for sensors offline
+ *=======================================================================================================================
+ */
+void sensors_observe(float sv[][SV_MAX]) {
+  unsigned int i;
+  int j;
+
+  // Start conversions on the sensors that need one and wait once for the slowest
+  sensors_start();
+  sensors_wait();
+
+  for (i=0; i<SENSOR_COUNT; i++) {
+    for (j=0; j<SV_MAX; j++) {
+      sv[i][j] = (*sensors[i].exists) ? NAN : 0.0;
+    }
+    if (*sensors[i].exists && !sensors[i].read(sv[i])) {
+      for (j=0; j<SV_MAX; j++) {
+        sv[i][j] = NAN;
+      }
+    }
+  }
+
+  // Second phase conversions were started by the reads above
+  sensors_wait();
+  for (i=0; i<SENSOR_COUNT; i++) {
+    if (*sensors[i].exists && sensors[i].finish) {
+      sensors[i].finish(sv[i]);
+    }
+  }
+
+  for (i=0; i<SENSOR_COUNT; i++) {
+    if (*sensors[i].exists) {
+      sensors_qc(&sensors[i], sv[i]);
+    }
+  }
+}
+
+/* 
+ *=======================================================================================================================
+ * sensor_measure() - One measurement from a single sensor, values not read are NAN
+ *=======================================================================================================================
+ */
+void sensor_measure(const SENSOR_DESC *s, float v[]) {
+  for (int j=0; j<SV_MAX; j++) {
+    v[j] = NAN;
+  }
+
+  sensors_ready = System.millis();
+  if (s->start) {
+    sensors_ready_in(s->start());
+  }
+  sensors_wait();
+  if (!s->read(v)) {
+    return;
+  }
+  if (s->finish) {
+    sensors_wait();
+    s->finish(v);
+  }
+}
@@ -18,14 +18,305 @@
 /*
  * =======================================================================================================================
  *  Distance Gauge
+ *
+ *  Samples are collected by a software timer every DG_SAMPLE_MS. The sampler is started at boot and on wake up so
+ *  the samples are taken while NetworkConnect() is still attaching. When OBS_Do() asks for the median the buffer is
+ *  normally already full and the modem does not sit powered waiting on 15s of distance readings.
+ *
+ *  If the sampler was not started, or the completed samples are older than DG_MAX_AGE_MS (long connect or no
+ *  clock), distance_gauge_median() starts a new set and waits for it.
+ *
+ *  With cf_dg_mad set, sampling stops early once the MAD of the samples so far has been at or under cf_dg_mad
+ *  for cf_dg_stable samples in a row (after cf_dg_min samples). Noisy readings, falling snow or turbulent water,
+ *  keep sampling up to cf_dg_max samples. The number of samples used is reported as "sgn".
+ *
+ *  With cf_dg_burst set, the sleep between observations is broken up. Every cf_dg_burst seconds, counting back
+ *  from the next observation, we wake with the modem off and the display asleep, take cf_dg_burst_n samples into
+ *  a retained aggregate and go back to sleep. The observation then reports the interval's samples instead of
+ *  taking its own set.
+ *
+ *  With cf_rr_rate set, each observation's median is compared with the last. When the distance is changing faster
+ *  than cf_rr_rate mm/min we go into rapid reporting, observing every cf_rr_cadence seconds with the modem left on,
+ *  until cf_rr_hold observations in a row are calm. Sleep bursts check the rate too and cut the sleep short.
  * =======================================================================================================================
  */
 #define DISTANCEGAUGE   A3
-#define DG_BUCKETS      60
+#define DG_BUCKETS      60              // Samples taken when early stop is disabled
+#define DG_MAX_BUCKETS  240             // Most samples early stop can extend to
+#define DG_SAMPLE_MS    250             // Time between samples
+#define DG_MAX_AGE_MS   120000          // Completed samples older than this are retaken
+#define DG_WAIT_MS      2000            // Margin past the longest sample set before we stop waiting on the sampler
+#define DG_IDLE         0               // Sampler states
+#define DG_SAMPLING     1
+#define DG_DONE         2
+#define DG_PLO          10              // Low percentile returned with the median
+#define DG_PHI          90              // High percentile returned with the median
+#define DG_OUTLIER_K    3.0             // Outlier when further than K scaled MADs from the median
+#define DG_BURST_MS     150             // Time between samples in a sleep burst, sensor reading cycle
+#define DG_AGG_MAGIC    0x44474147      // "DGAG" - Retained aggregate is valid
+#define DG_ROLL         20              // Rolling median window, 5s of samples at 4Hz
+#define RR_MAX_GAP      1800            // Seconds, medians further apart than this are not used for a rate
 char SD_5M_DIST_FILE[] = "5MDIST.TXT";  // If file exists use adjustment of 1.25. No file, then 10m Sensor is 2.5
 float dg_adjustment = 2.5;              // Default sensor is 10m 
-unsigned int dg_bucket = 0;             //  Distance Buckets
-unsigned int dg_buckets[DG_BUCKETS];
+volatile unsigned int dg_bucket = 0;    //  Distance Buckets
+unsigned int dg_buckets[DG_MAX_BUCKETS];
+unsigned int dg_scratch[DG_MAX_BUCKETS];  // Work space for the statistics, main thread only
+unsigned int dg_timer_scratch[DG_MAX_BUCKETS];  // Work space for the early stop MAD, timer thread only
+unsigned int dg_samples = 0;            // Number of samples in the last set
+int dg_stable = 0;                      // Samples in a row with MAD under cf_dg_mad
+volatile int dg_state = DG_IDLE;        // Sampler state
+volatile uint64_t dg_done_ms = 0;       // System.millis() when the last sample was taken
+unsigned int dg_plo = 0;                // DG_PLO percentile of the last set of samples
+unsigned int dg_phi = 0;                // DG_PHI percentile of the last set of samples
+unsigned int dg_minimum = 0;            // Statistics of the last set of samples
+unsigned int dg_maximum = 0;
+unsigned int dg_mad = 0;                // Median absolute deviation
+unsigned int dg_outliers = 0;           // Samples the median rejected as outliers
+unsigned int dg_roll[DG_ROLL];          // Rolling window ring, oldest sample at dg_roll_i once full
+unsigned int dg_roll_sorted[DG_ROLL];   // Rolling window samples in order
+int dg_roll_n = 0;                      // Samples in the rolling window
+int dg_roll_i = 0;                      // Next ring slot
+
+typedef struct {
+  uint32_t magic;                       // DG_AGG_MAGIC when the below is valid
+  uint32_t obs;                         // Unix time of the observation the samples are for
+  unsigned int bursts;                  // Bursts taken
+  unsigned int count;                   // Samples taken
+  unsigned int samples[DG_MAX_BUCKETS];
+} DG_AGGREGATE;
+
+retained DG_AGGREGATE dg_agg;           // Sleep burst samples survive sleep and a reset
+
+bool rr_rapid = false;                  // In rapid reporting
+float rr_rate = 0.0;                    // mm/min, last distance rate of change
+unsigned int rr_last = 0;               // Last observation median
+time32_t rr_last_ts = 0;                // Time of the last observation median
+int rr_calm = 0;                        // Calm observations in a row while in rapid reporting
+
+// Prototyping functions to aviod compile function unknown issue.
+void DG_Sample();
+int seconds_to_next_obs();
+bool RR_Update(unsigned int distance, bool observation);
+
+Timer dg_timer(DG_SAMPLE_MS, DG_Sample);
+
+/* 
+ *=======================================================================================================================
+ * DG_Sample() - Timer callback, take the next distance sample
+ *=======================================================================================================================
+ */
+void DG_Sample() {
+  if (dg_state != DG_SAMPLING) {
+    return;
+  }
+
+  dg_buckets[dg_bucket] = (int) analogRead(DISTANCEGAUGE) * dg_adjustment;
+  dg_bucket++;
+
+  bool done = false;
+  if (cf_dg_mad) {
+    if (dg_bucket >= (unsigned int) cf_dg_min) {
+      memcpy (dg_timer_scratch, dg_buckets, dg_bucket * sizeof(unsigned int));
+      if (mymad(dg_timer_scratch, dg_bucket) <= (unsigned int) cf_dg_mad) {
+        dg_stable++;
+      }
+      else {
+        dg_stable = 0;
+      }
+      done = (dg_stable >= cf_dg_stable);
+    }
+    done = done || (dg_bucket >= (unsigned int) cf_dg_max);
+  }
+  else {
+    done = (dg_bucket >= DG_BUCKETS);
+  }
+
+  if (done) {
+    dg_done_ms = System.millis();
+    dg_state = DG_DONE;
+  }
+}
+
+/* 
+ *=======================================================================================================================
+ * DG_Burst() - Take a short burst of distance samples into the retained aggregate
+ *=======================================================================================================================
+ */
+void DG_Burst() {
+  now = rtc.now();
+  uint32_t obs = now.unixtime() + seconds_to_next_obs();
+
+  // Start a new aggregate for this observation interval
+  if ((dg_agg.magic != DG_AGG_MAGIC) || (dg_agg.obs != obs) || (dg_agg.count > DG_MAX_BUCKETS)) {
+    dg_agg.magic = DG_AGG_MAGIC;
+    dg_agg.obs = obs;
+    dg_agg.bursts = 0;
+    dg_agg.count = 0;
+  }
+
+  for (int i=0; (i < cf_dg_burst_n) && (dg_agg.count < DG_MAX_BUCKETS); i++) {
+    if (i) {
+      delay(DG_BURST_MS);
+    }
+    dg_agg.samples[dg_agg.count++] = (int) analogRead(DISTANCEGAUGE) * dg_adjustment;
+  }
+  dg_agg.bursts++;
+}
+
+/* 
+ *=======================================================================================================================
+ * DG_AggReady() - Do the sleep bursts have samples for the observation we are making now
+ *=======================================================================================================================
+ */
+bool DG_AggReady() {
+  if (!cf_dg_burst || (dg_agg.magic != DG_AGG_MAGIC) || !dg_agg.count || (dg_agg.count > DG_MAX_BUCKETS)) {
+    return (false);
+  }
+
+  // The observation time has passed, but not by more than we allow samples to age
+  now = rtc.now();
+  uint32_t t = now.unixtime();
+  return ((t >= dg_agg.obs) && ((t - dg_agg.obs) <= (DG_MAX_AGE_MS/1000)));
+}
+
+/* 
+ *=======================================================================================================================
+ * DG_SleepBursts() - Sleep toward the next observation waking every cf_dg_burst seconds to take a burst
+ * 
+ *  Burst wakes are aligned to the observation, cf_dg_burst seconds apart counting back from it. Returns with
+ *  cf_dg_burst seconds or less to go, the caller sleeps the rest of the way.
+ *=======================================================================================================================
+ */
+void DG_SleepBursts() {
+  int s;
+
+  while (cf_dg_burst && !rr_rapid && ((s = seconds_to_next_obs()) > cf_dg_burst)) {
+    int r = ((s-1) / cf_dg_burst) * cf_dg_burst; // Seconds before the observation of the next burst
+
+    SystemSleepConfiguration config;
+    config.mode(SystemSleepMode::ULTRA_LOW_POWER).duration((s-r)*1000);
+    System.sleep(config);
+
+    PERF_BurstStart();
+    DG_Burst();
+
+    // Distance changing fast, cut the sleep short and get an observation out
+    bool rapid = false;
+    if (cf_rr_rate) {
+      unsigned int n = (dg_agg.count < (unsigned int) cf_dg_burst_n) ? dg_agg.count : cf_dg_burst_n;
+      memcpy (dg_scratch, &dg_agg.samples[dg_agg.count - n], n * sizeof(unsigned int));
+      if (RR_Update(myselect(dg_scratch, n, (n+1) / 2 - 1), false)) {
+        dg_agg.magic = 0; // Observation will be sooner, take a fresh set of samples
+        rapid = true;
+      }
+    }
+    PERF_BurstEnd();
+    if (rapid) {
+      break;
+    }
+  }
+}
+
+/* 
+ *=======================================================================================================================
+ * DG_Start() - Start collecting a new set of distance samples in the background
+ *=======================================================================================================================
+ */
+void DG_Start() {
+  if (DG_AggReady()) {
+    return; // Sleep bursts already have this interval's samples
+  }
+
+  dg_timer.stop();
+  dg_bucket = 0;
+  dg_stable = 0;
+  dg_state = DG_SAMPLING;
+  dg_timer.start();
+}
+
+/* 
+ *=======================================================================================================================
+ * DG_Stats() - Spread of the last set of samples around the median
+ * 
+ *  A sample is counted as an outlier when it is more than DG_OUTLIER_K * 1.4826 * MAD (the MAD scaled to a
+ *  standard deviation) plus one ADC step away from the median. The extra step keeps a MAD of 0 from counting
+ *  every reading that is not exactly the median.
+ *=======================================================================================================================
+ */
+void DG_Stats(unsigned int median) {
+  memcpy (dg_scratch, dg_buckets, dg_samples * sizeof(unsigned int));
+  dg_mad = mymad(dg_scratch, dg_samples);
+
+  unsigned int limit = (unsigned int) ((DG_OUTLIER_K * 1.4826 * dg_mad) + dg_adjustment);
+
+  dg_minimum = dg_buckets[0];
+  dg_maximum = dg_buckets[0];
+  dg_outliers = 0;
+  for (unsigned int i=0; i<dg_samples; i++) {
+    unsigned int d = dg_buckets[i];
+    if (d < dg_minimum) {
+      dg_minimum = d;
+    }
+    if (d > dg_maximum) {
+      dg_maximum = d;
+    }
+    if (((d > median) ? (d - median) : (median - d)) > limit) {
+      dg_outliers++;
+    }
+  }
+}
+
+/* 
+ *=======================================================================================================================
+ * DG_RollAdd() - Add a sample to the rolling window, dropping the oldest once full, return the window median
+ * 
+ *  The window is kept in order as it changes, a binary search and one move each for the sample leaving and the
+ *  sample arriving, so the median is there without sorting the window each time.
+ *=======================================================================================================================
+ */
+unsigned int DG_RollAdd(unsigned int d) {
+  int lo, hi, mid;
+
+  if (dg_roll_n == DG_ROLL) {
+    // Remove the oldest sample from the ordered window
+    unsigned int old = dg_roll[dg_roll_i];
+    lo = 0;
+    hi = dg_roll_n - 1;
+    while (lo < hi) {
+      mid = (lo + hi) / 2;
+      if (dg_roll_sorted[mid] < old) {
+        lo = mid + 1;
+      }
+      else {
+        hi = mid;
+      }
+    }
+    memmove(&dg_roll_sorted[lo], &dg_roll_sorted[lo+1], (dg_roll_n - lo - 1) * sizeof(unsigned int));
+    dg_roll_n--;
+  }
+
+  // Insert after any equal samples
+  lo = 0;
+  hi = dg_roll_n;
+  while (lo < hi) {
+    mid = (lo + hi) / 2;
+    if (dg_roll_sorted[mid] <= d) {
+      lo = mid + 1;
+    }
+    else {
+      hi = mid;
+    }
+  }
+  memmove(&dg_roll_sorted[lo+1], &dg_roll_sorted[lo], (dg_roll_n - lo) * sizeof(unsigned int));
+  dg_roll_sorted[lo] = d;
+  dg_roll_n++;
+
+  dg_roll[dg_roll_i] = d;
+  dg_roll_i = (dg_roll_i + 1) % DG_ROLL;
+
+  // Same (N+1)/2 median index as distance_gauge_median()
+  return (dg_roll_sorted[(dg_roll_n + 1) / 2 - 1]);
+}
 
 /* 
  *=======================================================================================================================
@@ -33,180 +324,191 @@ unsigned int dg_buckets[DG_BUCKETS];
  *=======================================================================================================================
  */
 unsigned int distance_gauge_median() {
-  int i;
+  unsigned int median;
+
+  // Use the samples from the sleep bursts, only once
+  if (DG_AggReady()) {
+    dg_timer.stop();
+    memcpy (dg_buckets, dg_agg.samples, dg_agg.count * sizeof(unsigned int));
+    dg_bucket = dg_agg.count;
+    dg_state = DG_DONE;
+    dg_done_ms = System.millis();
+    dg_agg.magic = 0;
 
-  for (i=0; i<DG_BUCKETS; i++) {
-    // delay(500);
-    delay(250);
-    dg_buckets[i] = (int) analogRead(DISTANCEGAUGE) * dg_adjustment;;
-    // sprintf (Buffer32Bytes, "SG[%02d]:%d", i, od_buckets[i]);
-    // OutputNS (Buffer32Bytes);
+    sprintf (Buffer32Bytes, "DG:%d Bursts %d", dg_agg.bursts, dg_agg.count);
+    Output (Buffer32Bytes);
   }
+
+  if ((dg_state == DG_IDLE) || 
+      ((dg_state == DG_DONE) && ((System.millis() - dg_done_ms) > DG_MAX_AGE_MS))) {
+    DG_Start();
+  }
+
+  // Wait on the sampler to fill the buckets, no longer than the most samples it can take
+  uint64_t deadline = System.millis() + (uint64_t) ((cf_dg_mad) ? cf_dg_max : DG_BUCKETS) * DG_SAMPLE_MS + DG_WAIT_MS;
+  while ((dg_state == DG_SAMPLING) && (System.millis() < deadline)) {
+    lux_poll();
+    delay(DG_SAMPLE_MS/5);
+  }
+  dg_timer.stop();
+  if (dg_state == DG_SAMPLING) {
+    // Sampler stalled, use what it has
+    Output ("DG:Timeout");
+    if (dg_bucket == 0) {
+      dg_buckets[dg_bucket++] = (int) analogRead(DISTANCEGAUGE) * dg_adjustment;
+    }
+  }
+  dg_state = DG_IDLE; // Next call takes a new set of samples
+  dg_samples = dg_bucket;
   
-  mysort(dg_buckets, DG_BUCKETS);
-  i = (DG_BUCKETS+1) / 2 - 1; // -1 as array indexing in C starts from 0
+  // Median index matches the (N+1)/2 of the old full sort, then the percentiles either side of it
+  median = myselect(dg_buckets, dg_samples, (dg_samples+1) / 2 - 1);
+  dg_plo = mypercentile(dg_buckets, dg_samples, DG_PLO);
+  dg_phi = mypercentile(dg_buckets, dg_samples, DG_PHI);
+  DG_Stats(median);
   
-  return (dg_buckets[i]);
+  return (median);
+}
+
+
+/* 
+ *=======================================================================================================================
+ * RR_Update() - Distance rate of change since the last observation, enter or leave rapid reporting
+ * 
+ *  observation is false for a sleep burst check, the burst can start rapid reporting but does not replace the
+ *  last observation median. Returns true when rapid reporting is entered.
+ *=======================================================================================================================
+ */
+bool RR_Update(unsigned int distance, bool observation) {
+  bool entered = false;
+
+  if (!cf_rr_rate) {
+    rr_rapid = false;
+    return (false);
+  }
+
+  time32_t t = Time.now();
+  if (rr_last_ts && (t > rr_last_ts) && ((t - rr_last_ts) <= RR_MAX_GAP)) {
+    rr_rate = abs((int) distance - (int) rr_last) * 60.0 / (t - rr_last_ts);
+
+    if (rr_rate >= cf_rr_rate) {
+      rr_calm = 0;
+      if (!rr_rapid) {
+        rr_rapid = true;
+        entered = true;
+        Output ("RR:RAPID");
+        SystemStatusBits |= SSB_RAPID;  // Turn On Bit
+      }
+    }
+    else if (observation && rr_rapid && (++rr_calm >= cf_rr_hold)) {
+      rr_rapid = false;
+      Output ("RR:NORMAL");
+      SystemStatusBits &= ~SSB_RAPID; // Turn Off Bit
+    }
+  }
+
+  if (observation) {
+    rr_last = distance;
+    rr_last_ts = t;
+  }
+  return (entered);
 }
 
 
 /*
  * ======================================================================================================================
- * I2C_Check_Sensors() - See if each I2C sensor responds on the bus and take action accordingly             
+ *  I2C Presence Scan
+ * 
+ *  Each sensor address in the descriptor table is probed once per check, under one Wire.begin(), into a 128 bit
+ *  presence bitmap. Drivers are only started again when a sensor's presence bit changed from the last check. A
+ *  sensor that answers on the bus but keeps failing begin() is retried with an exponential backoff, skipping
+ *  1, 3, 7 ... up to I2C_BACKOFF_MAX checks, so a dead sensor does not cost a begin() sequence on every wake.
  * ======================================================================================================================
  */
-void I2C_Check_Sensors() {
+#define I2C_BACKOFF_MAX   63            // Most checks skipped between begin() retries of a failing sensor
+#define I2C_BIT(map, a)   ((map[(a) >> 5] >> ((a) & 0x1F)) & 1)
+
+uint32_t i2c_present[4];                // Addresses that answered on the last scan
+uint32_t i2c_present_last[4];           // Addresses that answered on the scan before that
+byte i2c_fails[SENSOR_COUNT];           // begin() failures in a row while present
+byte i2c_skip[SENSOR_COUNT];            // Checks left before the next begin() retry
 
-  // BMX_1 Barometric Pressure 
-  if (I2C_Device_Exist (BMX_ADDRESS_1)) {
-    // Sensor online but our state had it offline
-    if (BMX_1_exists == false) {
-      if (BMX_1_chip_id == BMP280_CHIP_ID) {
-        if (bmp1.begin(BMX_ADDRESS_1)) { 
-          BMX_1_exists = true;
-          Output ("BMP1 ONLINE");
-          SystemStatusBits &= ~SSB_BMX_1; // Turn Off Bit
-        } 
+/*
+ * ======================================================================================================================
+ * I2C_Scan() - Probe each sensor address once and fill the presence bitmap
+ * ======================================================================================================================
+ */
+void I2C_Scan() {
+  memcpy(i2c_present_last, i2c_present, sizeof(i2c_present));
+  memset(i2c_present, 0, sizeof(i2c_present));
+
+  Wire.begin();
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    byte a = sensors[i].address & 0x7F;
+    bool probed = false;
+
+    for (unsigned int k=0; k<i; k++) {
+      if (sensors[k].address == sensors[i].address) {
+        probed = true;  // Shared address, already probed on this scan
+        break;
       }
-      else if (BMX_1_chip_id == BME280_BMP390_CHIP_ID) {
-        if (BMX_1_type == BMX_TYPE_BME280) {
-          if (bme1.begin(BMX_ADDRESS_1)) { 
-            BMX_1_exists = true;
-            Output ("BME1 ONLINE");
-            SystemStatusBits &= ~SSB_BMX_1; // Turn Off Bit
-          } 
-        }
-        if (BMX_1_type == BMX_TYPE_BMP390) {
-          if (bm31.begin_I2C(BMX_ADDRESS_1)) {
-            BMX_1_exists = true;
-            Output ("BMP390_1 ONLINE");
-            SystemStatusBits &= ~SSB_BMX_1; // Turn Off Bit
-          }
-        }        
+    }
+    if (!probed) {
+      if (I2C_Transaction(a, NULL, 0, NULL, 0) == 0) {
+        i2c_present[a >> 5] |= (1UL << (a & 0x1F));
       }
-      else {
-        if (bm31.begin_I2C(BMX_ADDRESS_1)) { 
-          BMX_1_exists = true;
-          Output ("BM31 ONLINE");
-          SystemStatusBits &= ~SSB_BMX_1; // Turn Off Bit
-        }                  
-      }      
     }
   }
-  else {
-    // Sensor offline but our state has it online
-    if (BMX_1_exists == true) {
-      BMX_1_exists = false;
-      Output ("BMX1 OFFLINE");
-      SystemStatusBits |= SSB_BMX_1;  // Turn On Bit 
-    }    
-  }
-
-  // BMX_2 Barometric Pressure 
-  if (I2C_Device_Exist (BMX_ADDRESS_2)) {
-    // Sensor online but our state had it offline
-    if (BMX_2_exists == false) {
-      if (BMX_2_chip_id == BMP280_CHIP_ID) {
-        if (bmp2.begin(BMX_ADDRESS_2)) { 
-          BMX_2_exists = true;
-          Output ("BMP2 ONLINE");
-          SystemStatusBits &= ~SSB_BMX_2; // Turn Off Bit
-        } 
-      }
-      else if (BMX_2_chip_id == BME280_BMP390_CHIP_ID) {
-        if (BMX_2_type == BMX_TYPE_BME280) {
-          if (bme1.begin(BMX_ADDRESS_2)) { 
-            BMX_2_exists = true;
-            Output ("BME2 ONLINE");
-            SystemStatusBits &= ~SSB_BMX_2; // Turn Off Bit
-          } 
+}
+
+/*
+ * ======================================================================================================================
+ * I2C_Check_Sensors() - See if each I2C sensor responds on the bus and take action accordingly             
+ * ======================================================================================================================
+ */
+void I2C_Check_Sensors() {
+  I2C_Scan();
+
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    const SENSOR_DESC *s = &sensors[i];
+    byte a = s->address & 0x7F;
+    bool changed = (I2C_BIT(i2c_present, a) != I2C_BIT(i2c_present_last, a));
+
+    if (I2C_BIT(i2c_present, a)) {
+      // Sensor online but our state had it offline, see if we can bring sensor online
+      if (*s->exists == false) {
+        if (changed) {
+          i2c_fails[i] = 0;  // Sensor showed up on the bus, try it now
+          i2c_skip[i] = 0;
+        }
+        if (i2c_skip[i]) {
+          i2c_skip[i]--;
         }
-        if (BMX_2_type == BMX_TYPE_BMP390) {
-          if (bm31.begin_I2C(BMX_ADDRESS_2)) {
-            BMX_1_exists = true;
-            Output ("BMP390_1 ONLINE");
-            SystemStatusBits &= ~SSB_BMX_2; // Turn Off Bit
+        else if (s->begin()) {
+          *s->exists = true;
+          i2c_fails[i] = 0;
+          sprintf (Buffer32Bytes, "%s ONLINE", s->name);
+          Output (Buffer32Bytes);
+          SystemStatusBits &= ~s->ssb; // Turn Off Bit
+        }
+        else {
+          if (i2c_fails[i] < 6) {
+            i2c_fails[i]++;
           }
-        }        
-      }
-      else {
-         if (bm32.begin_I2C(BMX_ADDRESS_2)) { 
-          BMX_2_exists = true;
-          Output ("BM32 ONLINE");
-          SystemStatusBits &= ~SSB_BMX_2; // Turn Off Bit
-        }                         
-      }     
-    }
-  }
-  else {
-    // Sensor offline but we our state has it online
-    if (BMX_2_exists == true) {
-      BMX_2_exists = false;
-      Output ("BMX2 OFFLINE");
-      SystemStatusBits |= SSB_BMX_2;  // Turn On Bit 
-    }    
-  }
-
-  // HTU21DF Humidity & Temp Sensor
-  if (I2C_Device_Exist (HTU21DF_I2CADDR)) {
-    // Sensor online but our state had it offline
-    if (HTU21DF_exists == false) {
-      // See if we can bring sensor online
-      if (htu.begin()) {
-        HTU21DF_exists = true;
-        Output ("HTU ONLINE");
-        SystemStatusBits &= ~SSB_HTU21DF; // Turn Off Bit
-      }
-    }
-  }
-  else {
-    // Sensor offline but we our state has it online
-    if (HTU21DF_exists == true) {
-      HTU21DF_exists = false;
-      Output ("HTU OFFLINE");
-      SystemStatusBits |= SSB_HTU21DF;  // Turn On Bit
-    }   
-  }
-
-  // SI1145 UV index & IR & Visible Sensor
-  if (I2C_Device_Exist (SI1145_ADDR)) {
-    // Sensor online but our state had it offline
-    if (SI1145_exists == false) {
-      // See if we can bring sensore online
-      if (uv.begin()) {
-        SI1145_exists = true;
-        Output ("SI ONLINE");
-        SystemStatusBits &= ~SSB_SI1145; // Turn Off Bit
+          i2c_skip[i] = min((1 << i2c_fails[i]) - 1, I2C_BACKOFF_MAX);
+          sprintf (Buffer32Bytes, "%s ERR %d", s->name, i2c_skip[i]);
+          Output (Buffer32Bytes);
+        }
       }
     }
-  }
-  else {
-    // Sensor offline but we our state has it online
-    if (SI1145_exists == true) {
-      SI1145_exists = false;
-      Output ("SI OFFLINE");
-      SystemStatusBits |= SSB_SI1145;  // Turn On Bit
-    }   
-  }
-
-  // VEML7700 Lux 
-  if (I2C_Device_Exist (VEML7700_ADDRESS)) {
-    // Sensor online but our state had it offline
-    if (VEML7700_exists == false) {
-      // See if we can bring sensor online
-      if (veml.begin()) {
-        VEML7700_exists = true;
-        Output ("LUX ONLINE");
-        SystemStatusBits &= ~SSB_LUX; // Turn Off Bit
+    else {
+      // Sensor offline but our state has it online
+      if (*s->exists == true) {
+        *s->exists = false;
+        sprintf (Buffer32Bytes, "%s OFFLINE", s->name);
+        Output (Buffer32Bytes);
+        SystemStatusBits |= s->ssb;  // Turn On Bit
       }
     }
   }
-  else {
-    // Sensor offline but we our state has it online
-    if (VEML7700_exists == true) {
-      VEML7700_exists = false;
-      Output ("LUX OFFLINE");
-      SystemStatusBits |= SSB_LUX;  // Turn On Bit
-    }   
-  }
 }
\ No newline at end of file
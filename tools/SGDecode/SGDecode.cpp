@@ -0,0 +1,231 @@
+/*
+ * ======================================================================================================================
+ *  SGDecode.cpp - Decode SGB and SGC events back into SG observation JSON
+ * ======================================================================================================================
+ */
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include "SGDecode.h"
+
+/*
+ * ======================================================================================================================
+ *  Schema 1 - Firmware sensors[] table as of SSG-ULP-20250924v16
+ * ======================================================================================================================
+ */
+static const SGD_SENSOR sgd_sensors_1[] = {
+  {"BMX1", 3, {"bp1", "bt1", "bh1"}, {4, 2, 2}},
+  {"BMX2", 3, {"bp2", "bt2", "bh2"}, {4, 2, 2}},
+  {"HTU",  2, {"ht1", "hh1"},        {2, 2}},
+  {"MCP1", 1, {"mt1"},               {2}},
+  {"MCP2", 1, {"mt2"},               {2}},
+  {"SHT1", 2, {"st1", "sh1"},        {2, 2}},
+  {"SHT2", 2, {"st2", "sh2"},        {2, 2}},
+  {"HIH8", 2, {"ht2", "hh2"},        {2, 2}},
+  {"SI",   3, {"sv1", "si1", "su1"}, {2, 2, 2}},
+  {"VEML", 1, {"lx"},                {2}},
+};
+
+static const SGD_SCHEMA sgd_schemas[] = {
+  {1, sgd_sensors_1, sizeof(sgd_sensors_1)/sizeof(sgd_sensors_1[0])},
+};
+
+/*
+ * ======================================================================================================================
+ * SGDecode_Schema() - Schema for an id, NULL if unknown
+ * ======================================================================================================================
+ */
+const SGD_SCHEMA *SGDecode_Schema(int id) {
+  for (const SGD_SCHEMA &s : sgd_schemas) {
+    if (s.id == id) {
+      return (&s);
+    }
+  }
+  return (NULL);
+}
+
+/*
+ * ======================================================================================================================
+ * sgd_fields() - Split a line into integers, false if a field is not an integer
+ * ======================================================================================================================
+ */
+static bool sgd_fields(const std::string &line, std::vector<long long> &f) {
+  size_t start = 0;
+
+  f.clear();
+  while (start <= line.size()) {
+    size_t end = line.find(',', start);
+    if (end == std::string::npos) {
+      end = line.size();
+    }
+    std::string field = line.substr(start, end - start);
+    char *p;
+    errno = 0;
+    long long v = strtoll(field.c_str(), &p, 10);
+    if (field.empty() || *p || errno) {
+      return (false);
+    }
+    f.push_back(v);
+    start = end + 1;
+  }
+  return (true);
+}
+
+/*
+ * ======================================================================================================================
+ * sgd_scaled() - Append a scaled integer with precision decimal places, as the firmware JSON writes it
+ * ======================================================================================================================
+ */
+static void sgd_scaled(std::string &json, const char *key, long long v, int precision) {
+  char buf[64];
+  long long pow10 = 1;
+
+  for (int i=0; i<precision; i++) {
+    pow10 *= 10;
+  }
+  const char *sign = (v < 0) ? "-" : "";
+  unsigned long long a = (v < 0) ? -(unsigned long long) v : v;
+  if (precision) {
+    snprintf (buf, sizeof(buf), ",\"%s\":%s%llu.%0*llu", key, sign, a / pow10, precision, a % pow10);
+  }
+  else {
+    snprintf (buf, sizeof(buf), ",\"%s\":%s%llu", key, sign, a);
+  }
+  json += buf;
+}
+
+/*
+ * ======================================================================================================================
+ * sgd_int() - Append an integer
+ * ======================================================================================================================
+ */
+static void sgd_int(std::string &json, const char *key, long long v) {
+  sgd_scaled(json, key, v, 0);
+}
+
+/*
+ * ======================================================================================================================
+ * sgd_line() - Decode one positional line, ts is the time of the line before and is updated
+ * ======================================================================================================================
+ */
+static bool sgd_line(const SGD_SCHEMA *schema, const std::string &line, long long *ts, std::string &json,
+  std::string &error) {
+  std::vector<long long> f;
+  size_t n = 0;
+  char at[32];
+
+  if (!sgd_fields(line, f)) {
+    error = "field not an integer";
+    return (false);
+  }
+
+  // dt, flags, online, sg then the optional fields
+  if (f.size() < 4) {
+    error = "short line";
+    return (false);
+  }
+  *ts += f[n++];
+  if (*ts < 0) {
+    error = "time before the epoch";
+    return (false);
+  }
+  long long flags = f[n++];
+  long long online = f[n++];
+  long long sg = f[n++];
+
+  size_t need = n + ((flags & SGD_F_SGN) ? 1 : 0) + ((flags & SGD_F_SGRR) ? 1 : 0) + ((flags & SGD_F_STATS) ? 6 : 0) + 5;
+  for (int i=0; i<schema->count; i++) {
+    if (online & (1LL << i)) {
+      need += schema->sensors[i].nv;
+    }
+  }
+  if (online >> schema->count) {
+    error = "online bit not in schema";
+    return (false);
+  }
+  if (f.size() != need) {
+    error = "field count does not match flags and online bits";
+    return (false);
+  }
+
+  time_t t = (time_t) *ts;
+  struct tm tm;
+  gmtime_r(&t, &tm);
+  strftime(at, sizeof(at), "%Y-%m-%dT%H:%M:%S", &tm);
+
+  json = "{\"at\":\"";
+  json += at;
+  json += "\"";
+  sgd_int(json, "sg", sg);
+  if (flags & SGD_F_SGN) {
+    sgd_int(json, "sgn", f[n++]);
+  }
+  if (flags & SGD_F_SGRR) {
+    sgd_scaled(json, "sgrr", f[n++], 1);
+  }
+  if (flags & SGD_F_STATS) {
+    static const char *stats[] = {"sgmn", "sgmx", "sg10", "sg90", "sgmad", "sgro"};
+    for (const char *key : stats) {
+      sgd_int(json, key, f[n++]);
+    }
+  }
+  for (int i=0; i<schema->count; i++) {
+    if (online & (1LL << i)) {
+      const SGD_SENSOR *s = &schema->sensors[i];
+      for (int j=0; j<s->nv; j++) {
+        sgd_scaled(json, s->key[j], f[n++], s->precision[j]);
+      }
+    }
+  }
+  sgd_int(json, "bcs", f[n++]);
+  sgd_scaled(json, "bpc", f[n++], 4);
+  sgd_int(json, "cfr", f[n++]);
+  sgd_scaled(json, "css", f[n++], 4);
+  sgd_int(json, "hth", f[n++]);
+  json += "}";
+  return (true);
+}
+
+/*
+ * ======================================================================================================================
+ * SGDecode() - Decode an SGB or SGC payload into one SG JSON object per observation
+ * ======================================================================================================================
+ */
+bool SGDecode(const std::string &payload, std::vector<std::string> &json, std::string &error) {
+  std::vector<std::string> lines;
+  size_t start = 0;
+  long long ts = 0;
+
+  json.clear();
+  while (start <= payload.size()) {
+    size_t end = payload.find(';', start);
+    if (end == std::string::npos) {
+      end = payload.size();
+    }
+    lines.push_back(payload.substr(start, end - start));
+    start = end + 1;
+  }
+
+  char *p;
+  long id = strtol(lines[0].c_str(), &p, 10);
+  const SGD_SCHEMA *schema = SGDecode_Schema(id);
+  if (lines[0].empty() || *p || !schema) {
+    error = "unknown schema " + lines[0];
+    return (false);
+  }
+  if (lines.size() < 2) {
+    error = "no observations";
+    return (false);
+  }
+
+  for (size_t i=1; i<lines.size(); i++) {
+    std::string obs;
+    if (!sgd_line(schema, lines[i], &ts, obs, error)) {
+      error = "line " + std::to_string(i) + ": " + error;
+      return (false);
+    }
+    json.push_back(obs);
+  }
+  return (true);
+}
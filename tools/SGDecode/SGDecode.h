@@ -0,0 +1,65 @@
+/*
+ * ======================================================================================================================
+ *  SGDecode.h - Decode SGB and SGC events back into SG observation JSON
+ * ======================================================================================================================
+ *
+ *  Host side library for the ingest pipeline. The firmware publishes the Need to Send backlog as batched SGB events
+ *  and, with sg_compact=1 in CONFIG.TXT, observations as SGC events. Both carry the same payload
+ *
+ *    schema;line;line...
+ *
+ *  Each line is comma separated integers in N2S record order (see OBS.h Positional Observation Line)
+ *
+ *    dt,flags,online,sg,[sgn],[sgrr],[sgmn,sgmx,sg10,sg90,sgmad,sgro],values,bcs,bpc,cfr,css,hth
+ *
+ *  dt is signed seconds since the previous line, the RTC may have been set back between two records. The first
+ *  line has the observation time.
+ *
+ *  The schema fixes the sensor order, keys and precision. It is reported as "sgs" by the INFO event.
+ *  SGDecode() returns one JSON object per line, with the keys, order and precision of the SG event.
+ *
+ *  Build with the command line decoder
+ *    g++ -std=c++17 -O2 -Wall -o sgdecode sgdecode_main.cpp SGDecode.cpp
+ * ======================================================================================================================
+ */
+#ifndef SGDECODE_H
+#define SGDECODE_H
+
+#include <string>
+#include <vector>
+
+#define SGD_F_SGN       0x01    // sgn present
+#define SGD_F_SGRR      0x02    // sgrr present
+#define SGD_F_STATS     0x04    // Distance sample statistics present
+#define SGD_SV_MAX      3       // Most values from one sensor
+
+typedef struct {
+  const char *name;                   // Sensor as reported in the INFO sensors list
+  int nv;                             // Number of values
+  const char *key[SGD_SV_MAX];        // Observation JSON key of each value
+  int precision[SGD_SV_MAX];          // Decimal places, values are scaled by 10^precision
+} SGD_SENSOR;
+
+typedef struct {
+  int id;                             // Schema id, first field of the payload
+  const SGD_SENSOR *sensors;          // Firmware sensors[] table for this schema, online bit order
+  int count;
+} SGD_SCHEMA;
+
+/*
+ * ======================================================================================================================
+ * SGDecode_Schema() - Schema for an id, NULL if unknown
+ * ======================================================================================================================
+ */
+const SGD_SCHEMA *SGDecode_Schema(int id);
+
+/*
+ * ======================================================================================================================
+ * SGDecode() - Decode an SGB or SGC payload into one SG JSON object per observation
+ *
+ *  Returns false and sets error when the payload is not valid, json then holds the observations before the error.
+ * ======================================================================================================================
+ */
+bool SGDecode(const std::string &payload, std::vector<std::string> &json, std::string &error);
+
+#endif
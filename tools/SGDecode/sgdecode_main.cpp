@@ -0,0 +1,42 @@
+/*
+ * ======================================================================================================================
+ *  sgdecode_main.cpp - Decode SGB and SGC event payloads, one per line on stdin, to SG JSON lines on stdout
+ *
+ *  Build
+ *    g++ -std=c++17 -O2 -Wall -o sgdecode sgdecode_main.cpp SGDecode.cpp
+ *
+ *  Example
+ *    echo '1;1760000000,0,1,1234,10132512,2134,4512,4,987600,0,-712500,16' | ./sgdecode
+ *
+ *  Payloads that do not decode are reported on stderr with their line number and the exit status is 1.
+ * ======================================================================================================================
+ */
+#include <iostream>
+#include "SGDecode.h"
+
+int main() {
+  std::string payload;
+  std::vector<std::string> json;
+  std::string error;
+  int lineno = 0;
+  int status = 0;
+
+  while (std::getline(std::cin, payload)) {
+    lineno++;
+    if (!payload.empty() && (payload.back() == '\r')) {
+      payload.pop_back();
+    }
+    if (payload.empty()) {
+      continue;
+    }
+    bool ok = SGDecode(payload, json, error);
+    for (const std::string &obs : json) {
+      std::cout << obs << "\n";
+    }
+    if (!ok) {
+      std::cerr << "sgdecode: " << lineno << ": " << error << "\n";
+      status = 1;
+    }
+  }
+  return (status);
+}
@@ -0,0 +1,405 @@
+/*
+ * ======================================================================================================================
+ *  sglog.cpp - Export binary daily SD logs (/OBS/YYYYMMDD.bin) to CSV or JSON
+ * ======================================================================================================================
+ *
+ *  The firmware writes the binary log with sd_log=1 or 2 in CONFIG.TXT. See OBS.h Binary Daily Log and Need to Send
+ *  Record for the layout. A file is a header that carries the sensor table (names, keys, precision), then records
+ *
+ *    schema, length, flags, ts, online, sg, [sgn], [sgrr], [sgmn sgmx sg10 sg90 sgmad sgro],
+ *    the values of each online sensor, bcs, bpc, cfr, css, hth, CRC-16 of the record
+ *
+ *  Files are memory mapped and streamed record by record. A record that fails its CRC is skipped by scanning for
+ *  the next valid record. A last record cut short by a brown out is reported and dropped. Both are counted on
+ *  stderr, the rest of the file is still exported.
+ *
+ *  Build
+ *    g++ -std=c++17 -O2 -Wall -o sglog sglog.cpp
+ *
+ *  Usage
+ *    sglog [-c | -j] file.bin ...      -c CSV (default) with one column per key in the header, -j SG JSON lines
+ *
+ *  Exit status is 1 if a file could not be read or had a bad header, 0 otherwise.
+ * ======================================================================================================================
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LOG_MAGIC       "SGLB"
+#define LOG_VERSION     1
+#define LOG_NAME_LEN    6
+#define LOG_KEY_LEN     6
+#define LOG_VER_LEN     24
+#define LOG_HDR_FIXED   (10 + LOG_VER_LEN)
+#define SV_MAX          3
+#define LOG_HDR_SENSOR  (LOG_NAME_LEN + 1 + SV_MAX * (LOG_KEY_LEN + 1))
+#define REC_MIN         25              // Record with no optional fields and no sensors
+#define REC_TAIL        14              // bcs, bpc, cfr, css, hth
+#define F_SGN           0x01
+#define F_SGRR          0x02
+#define F_STATS         0x04
+
+typedef struct {
+  std::string name;
+  int nv;
+  std::string key[SV_MAX];
+  int precision[SV_MAX];
+} SENSOR;
+
+typedef struct {
+  int schema;
+  std::string version;
+  std::vector<SENSOR> sensors;
+} HEADER;
+
+typedef struct {
+  uint8_t flags;
+  uint32_t ts;
+  uint16_t online;
+  uint16_t sg, sgn;
+  float sgrr;
+  uint16_t stats[6];
+  std::vector<float> values;            // Online sensor values in header order
+  int8_t bcs;
+  float bpc;
+  uint8_t cfr;
+  float css;
+  uint32_t hth;
+} RECORD;
+
+static const char *stats_key[6] = {"sgmn", "sgmx", "sg10", "sg90", "sgmad", "sgro"};
+
+/*
+ * ======================================================================================================================
+ * crc16() - CRC-16/CCITT-FALSE, as the firmware SF.h
+ * ======================================================================================================================
+ */
+static uint16_t crc16(const uint8_t *p, size_t n) {
+  uint16_t crc = 0xFFFF;
+
+  while (n--) {
+    crc ^= (uint16_t) *p++ << 8;
+    for (int i=0; i<8; i++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+  }
+  return (crc);
+}
+
+template <typename T> static T get(const uint8_t *&p) {
+  T v;
+  memcpy(&v, p, sizeof(v));
+  p += sizeof(v);
+  return (v);
+}
+
+static std::string fixed_string(const uint8_t *p, size_t n) {
+  return (std::string((const char *) p, strnlen((const char *) p, n)));
+}
+
+/*
+ * ======================================================================================================================
+ * read_header() - Parse and check the file header, return its length or 0 if it is not valid
+ * ======================================================================================================================
+ */
+static size_t read_header(const uint8_t *buf, size_t size, HEADER &h) {
+  if ((size < LOG_HDR_FIXED + 2) || memcmp(buf, LOG_MAGIC, 4) || (buf[4] != LOG_VERSION)) {
+    return (0);
+  }
+  const uint8_t *p = buf + 8;
+  size_t len = get<uint16_t>(p);
+  size_t count = buf[6];
+  if ((len != LOG_HDR_FIXED + count * LOG_HDR_SENSOR + 2) || (len > size) || (count > 16)) {
+    return (0);
+  }
+  uint16_t crc;
+  memcpy(&crc, buf + len - 2, 2);
+  if (crc != crc16(buf, len - 2)) {
+    return (0);
+  }
+
+  h.schema = buf[5];
+  h.version = fixed_string(p, LOG_VER_LEN);
+  p += LOG_VER_LEN;
+  h.sensors.clear();
+  for (size_t i=0; i<count; i++) {
+    SENSOR s;
+    s.name = fixed_string(p, LOG_NAME_LEN);
+    p += LOG_NAME_LEN;
+    s.nv = *p++;
+    if (s.nv > SV_MAX) {
+      return (0);
+    }
+    for (int j=0; j<SV_MAX; j++) {
+      s.key[j] = fixed_string(p, LOG_KEY_LEN);
+      s.precision[j] = p[LOG_KEY_LEN];
+      p += LOG_KEY_LEN + 1;
+    }
+    h.sensors.push_back(s);
+  }
+  return (len);
+}
+
+/*
+ * ======================================================================================================================
+ * decode_record() - Decode a record whose length and CRC were checked, false if its fields do not add up
+ * ======================================================================================================================
+ */
+static bool decode_record(const HEADER &h, const uint8_t *rec, size_t len, RECORD &r) {
+  const uint8_t *p = rec + 2;
+  const uint8_t *end = rec + len;
+
+  r.flags = get<uint8_t>(p);
+  r.ts = get<uint32_t>(p);
+  r.online = get<uint16_t>(p);
+  r.sg = get<uint16_t>(p);
+
+  size_t need = ((r.flags & F_SGN) ? 2 : 0) + ((r.flags & F_SGRR) ? 4 : 0) + ((r.flags & F_STATS) ? 12 : 0) + REC_TAIL;
+  for (size_t i=0; i<h.sensors.size(); i++) {
+    if (r.online & (1 << i)) {
+      need += h.sensors[i].nv * sizeof(float);
+    }
+  }
+  if ((r.online >> h.sensors.size()) || ((size_t) (end - p) != need)) {
+    return (false);
+  }
+
+  r.sgn = (r.flags & F_SGN) ? get<uint16_t>(p) : 0;
+  r.sgrr = (r.flags & F_SGRR) ? get<float>(p) : 0;
+  for (int i=0; i<6; i++) {
+    r.stats[i] = (r.flags & F_STATS) ? get<uint16_t>(p) : 0;
+  }
+  r.values.clear();
+  for (size_t i=0; i<h.sensors.size(); i++) {
+    if (r.online & (1 << i)) {
+      for (int j=0; j<h.sensors[i].nv; j++) {
+        r.values.push_back(get<float>(p));
+      }
+    }
+  }
+  r.bcs = get<int8_t>(p);
+  r.bpc = get<float>(p);
+  r.cfr = get<uint8_t>(p);
+  r.css = get<float>(p);
+  r.hth = get<uint32_t>(p);
+  return (true);
+}
+
+static std::string timestamp(uint32_t ts) {
+  char buf[32];
+  time_t t = ts;
+  struct tm tm;
+
+  gmtime_r(&t, &tm);
+  strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", &tm);
+  return (buf);
+}
+
+/*
+ * ======================================================================================================================
+ * csv_columns() - Column names, every key the header can carry
+ * ======================================================================================================================
+ */
+static std::string csv_columns(const HEADER &h) {
+  std::string cols = "at,sg,sgn,sgrr";
+
+  for (const char *k : stats_key) {
+    cols += std::string(",") + k;
+  }
+  for (const SENSOR &s : h.sensors) {
+    for (int j=0; j<s.nv; j++) {
+      cols += "," + s.key[j];
+    }
+  }
+  return (cols + ",bcs,bpc,cfr,css,hth");
+}
+
+/*
+ * ======================================================================================================================
+ * emit() - One record as a CSV row, blank for fields not present, or as SG JSON
+ * ======================================================================================================================
+ */
+static void emit(const HEADER &h, const RECORD &r, bool json) {
+  size_t v = 0;
+
+  if (json) {
+    printf("{\"at\":\"%s\",\"sg\":%u", timestamp(r.ts).c_str(), r.sg);
+    if (r.flags & F_SGN) {
+      printf(",\"sgn\":%u", r.sgn);
+    }
+    if (r.flags & F_SGRR) {
+      printf(",\"sgrr\":%.1f", r.sgrr);
+    }
+    if (r.flags & F_STATS) {
+      for (int i=0; i<6; i++) {
+        printf(",\"%s\":%u", stats_key[i], r.stats[i]);
+      }
+    }
+    for (size_t i=0; i<h.sensors.size(); i++) {
+      if (r.online & (1 << i)) {
+        for (int j=0; j<h.sensors[i].nv; j++) {
+          printf(",\"%s\":%.*f", h.sensors[i].key[j].c_str(), h.sensors[i].precision[j], r.values[v++]);
+        }
+      }
+    }
+    printf(",\"bcs\":%d,\"bpc\":%.4f,\"cfr\":%u,\"css\":%.4f,\"hth\":%u}\n", r.bcs, r.bpc, r.cfr, r.css, r.hth);
+    return;
+  }
+
+  printf("%s,%u,", timestamp(r.ts).c_str(), r.sg);
+  if (r.flags & F_SGN) {
+    printf("%u", r.sgn);
+  }
+  printf(",");
+  if (r.flags & F_SGRR) {
+    printf("%.1f", r.sgrr);
+  }
+  for (int i=0; i<6; i++) {
+    if (r.flags & F_STATS) {
+      printf(",%u", r.stats[i]);
+    }
+    else {
+      printf(",");
+    }
+  }
+  for (size_t i=0; i<h.sensors.size(); i++) {
+    for (int j=0; j<h.sensors[i].nv; j++) {
+      if (r.online & (1 << i)) {
+        printf(",%.*f", h.sensors[i].precision[j], r.values[v++]);
+      }
+      else {
+        printf(",");
+      }
+    }
+  }
+  printf(",%d,%.4f,%u,%.4f,%u\n", r.bcs, r.bpc, r.cfr, r.css, r.hth);
+}
+
+/*
+ * ======================================================================================================================
+ * export_file() - Stream the records of one file, false if it could not be read or the header is bad
+ * ======================================================================================================================
+ */
+static bool export_file(const char *path, bool json, std::string &columns) {
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+
+  if ((fd < 0) || fstat(fd, &st)) {
+    perror(path);
+    if (fd >= 0) {
+      close(fd);
+    }
+    return (false);
+  }
+  size_t size = st.st_size;
+  if (size == 0) {
+    fprintf(stderr, "%s: empty\n", path);
+    close(fd);
+    return (false);
+  }
+  const uint8_t *buf = (const uint8_t *) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (buf == MAP_FAILED) {
+    perror(path);
+    return (false);
+  }
+  madvise((void *) buf, size, MADV_SEQUENTIAL);
+
+  HEADER h;
+  size_t off = read_header(buf, size, h);
+  if (!off) {
+    fprintf(stderr, "%s: not a binary SG log or bad header\n", path);
+    munmap((void *) buf, size);
+    return (false);
+  }
+  // CSV header line for the first file, and again when the sensor table changes
+  if (!json && (csv_columns(h) != columns)) {
+    columns = csv_columns(h);
+    printf("%s\n", columns.c_str());
+  }
+
+  size_t records = 0, bad = 0, skipped = 0;
+  bool torn = false;
+  RECORD r;
+  while (off < size) {
+    size_t len = (size - off >= 2) ? buf[off + 1] : 0;
+
+    if ((size - off < 2) || (buf[off] == h.schema && len >= REC_MIN && off + len + 2 > size)) {
+      torn = true;          // Cut short at the end of the file, brown out during the write
+      break;
+    }
+
+    uint16_t crc = 0;
+    if ((buf[off] == h.schema) && (len >= REC_MIN)) {
+      memcpy(&crc, buf + off + len, 2);
+    }
+    if ((buf[off] == h.schema) && (len >= REC_MIN) && (crc == crc16(buf + off, len)) &&
+        decode_record(h, buf + off, len, r)) {
+      if (skipped) {
+        bad++;
+        skipped = 0;
+      }
+      emit(h, r, json);
+      records++;
+      off += len + 2;
+    }
+    else {
+      skipped++;            // Scan a byte at a time for the next valid record
+      off++;
+    }
+  }
+  if (skipped) {
+    bad++;
+  }
+
+  fprintf(stderr, "%s: %s schema %d, %zu records", path, h.version.c_str(), h.schema, records);
+  if (bad) {
+    fprintf(stderr, ", %zu damaged stretches skipped", bad);
+  }
+  if (torn) {
+    fprintf(stderr, ", torn last record dropped");
+  }
+  fprintf(stderr, "\n");
+
+  munmap((void *) buf, size);
+  return (true);
+}
+
+int main(int argc, char **argv) {
+  bool json = false;
+  std::string columns;
+  int status = 0;
+  int i = 1;
+
+  for (; (i < argc) && (argv[i][0] == '-'); i++) {
+    if (!strcmp(argv[i], "-j")) {
+      json = true;
+    }
+    else if (!strcmp(argv[i], "-c")) {
+      json = false;
+    }
+    else {
+      fprintf(stderr, "usage: sglog [-c | -j] file.bin ...\n");
+      return (2);
+    }
+  }
+  if (i == argc) {
+    fprintf(stderr, "usage: sglog [-c | -j] file.bin ...\n");
+    return (2);
+  }
+
+  for (; i < argc; i++) {
+    if (!export_file(argv[i], json, columns)) {
+      status = 1;
+    }
+  }
+  return (status);
+}
@@ -0,0 +1,496 @@
+/*
+ * ======================================================================================================================
+ *  Particle.h - Host stand-in for the Device OS API used by the firmware and its libraries
+ *
+ *  Only what src/ and lib/ call is here. Time is virtual, see Sim.h. delay(), waits and sleeps advance the
+ *  virtual clock instead of blocking, software Timers fire as it passes their period.
+ * ======================================================================================================================
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <ctype.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+
+#define ARDUINO 10800
+#define PARTICLE 1
+#define PLATFORM_ARGON      12
+#define PLATFORM_BORON      13
+#ifndef PLATFORM_ID
+#define PLATFORM_ID         PLATFORM_BORON
+#endif
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef int32_t time32_t;
+typedef uint16_t pin_t;
+
+/*
+ * ======================================================================================================================
+ *  Pins
+ * ======================================================================================================================
+ */
+#define D0  0
+#define D1  1
+#define D5  5
+#define D7  7
+#define D8  8
+#define A2  12
+#define A3  13
+#define A4  14
+#define PWR 20
+#define BATT 21
+#define CHG 22
+#define SDA D0
+#define SCL D1
+
+#define LOW           0
+#define HIGH          1
+#define INPUT         0
+#define OUTPUT        1
+#define INPUT_PULLUP  2
+#define INPUT_PULLDOWN 3
+#define OPEN_DRAIN    4
+
+/*
+ * ======================================================================================================================
+ *  Wiring macros
+ * ======================================================================================================================
+ */
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+#define PRODUCT_VERSION(x)
+#define SYSTEM_MODE(x)
+#define SYSTEM_THREAD(x)
+#define retained
+#define F(x) ((const __FlashStringHelper *)(x))
+#define PSTR(x) (x)
+#define PGM_P const char *
+#define PROGMEM
+#define memcpy_P memcpy
+#define pgm_read_byte(x) (*(const uint8_t *)(x))
+#define pgm_read_word(x) (*(const uint16_t *)(x))
+#define pgm_read_dword(x) (*(const uint32_t *)(x))
+#define pgm_read_pointer(x) (*(x))
+#define bitRead(v, b) (((v) >> (b)) & 1)
+#define _BV(b) (1 << (b))
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#define constrain(a, l, h) ((a) < (l) ? (l) : ((a) > (h) ? (h) : (a)))
+#define I2C_BUFFER_LENGTH 32
+#define WITH_ACK 1
+#define NO_ACK 2
+#define PRIVATE 0
+#define TIME_FORMAT_ISO8601_FULL 0
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+#define firmware_update 1
+#define WEP 1
+#define WPA 2
+#define WPA2 3
+#define WPA_ENTERPRISE 4
+#define WPA2_ENTERPRISE 5
+#define UNSEC 0
+
+enum BitOrder { LSBFIRST = 0, MSBFIRST = 1 };
+class __FlashStringHelper;
+
+/*
+ * ======================================================================================================================
+ *  String
+ * ======================================================================================================================
+ */
+class String {
+public:
+  String() {}
+  String(const char *s) : s_(s ? s : "") {}
+  String(char c) : s_(1, c) {}
+  String(int v, int base = 10) { char b[34]; snprintf(b, sizeof(b), (base == 16) ? "%x" : "%d", v); s_ = b; }
+  const char *c_str() const { return s_.c_str(); }
+  int length() const { return (int) s_.size(); }
+  void reserve(int n) { s_.reserve(n); }
+  String &operator+=(const String &o) { s_ += o.s_; return *this; }
+  String &operator=(const char *s) { s_ = s ? s : ""; return *this; }
+  bool operator==(const char *s) const { return s_ == s; }
+private:
+  std::string s_;
+};
+
+/*
+ * ======================================================================================================================
+ *  Print and Stream
+ * ======================================================================================================================
+ */
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t n) { size_t i; for (i=0; i<n && write(buf[i]); i++) {} return i; }
+  size_t write(const char *s) { return write((const uint8_t *) s, strlen(s)); }
+  size_t print(const char *s) { return write(s); }
+  size_t print(const String &s) { return write(s.c_str()); }
+  size_t print(const __FlashStringHelper *s) { return write((const char *) s); }
+  size_t print(char c) { return write((uint8_t) c); }
+  size_t print(int v, int base = DEC) { return print((long) v, base); }
+  size_t print(unsigned int v, int base = DEC) { return print((unsigned long) v, base); }
+  size_t print(long v, int base = DEC) { return (base == DEC) ? printf("%ld", v) : print((unsigned long) v, base); }
+  size_t print(unsigned long v, int base = DEC) { return printf((base == HEX) ? "%lX" : (base == OCT) ? "%lo" : "%lu", v); }
+  size_t print(double v, int digits = 2) { return printf("%.*f", digits, v); }
+  size_t println() { return write("\r\n"); }
+  template <class T> size_t println(T v) { size_t n = print(v); return n + println(); }
+  template <class T> size_t println(T v, int f) { size_t n = print(v, f); return n + println(); }
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char b[256];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(b, sizeof(b), fmt, ap);
+    va_end(ap);
+    return write(b);
+  }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() { return -1; }
+  virtual void flush() {}
+  void setTimeout(unsigned long) {}
+  size_t readBytes(char *buf, size_t n) {
+    size_t i = 0;
+    int c;
+    while ((i < n) && ((c = read()) >= 0)) {
+      buf[i++] = (char) c;
+    }
+    return i;
+  }
+  size_t readBytesUntil(char t, char *buf, size_t n) {
+    size_t i = 0;
+    int c;
+    while ((i < n) && ((c = read()) >= 0) && (c != t)) {
+      buf[i++] = (char) c;
+    }
+    return i;
+  }
+};
+
+class USBSerial : public Stream {
+public:
+  void begin(long) {}
+  bool isConnected() { return true; }
+  operator bool() { return true; }
+  size_t write(uint8_t c);
+  using Print::write;
+  int available() { return 0; }
+  int read() { return -1; }
+};
+extern USBSerial Serial;
+
+/*
+ * ======================================================================================================================
+ *  Wire - I2C, devices are modeled in Sim.cpp
+ * ======================================================================================================================
+ */
+class WireTransmission {
+public:
+  WireTransmission(uint8_t address) : address_(address) {}
+  WireTransmission &quantity(size_t n) { quantity_ = n; return *this; }
+  WireTransmission &timeout(uint32_t ms) { timeout_ = ms; return *this; }
+  WireTransmission &stop(bool s) { stop_ = s; return *this; }
+  uint8_t address_;
+  size_t quantity_ = 0;
+  uint32_t timeout_ = 0;
+  bool stop_ = true;
+};
+
+class TwoWire : public Stream {
+public:
+  void begin() { enabled_ = true; }
+  void end() { enabled_ = false; }
+  void reset() {}
+  bool isEnabled() { return enabled_; }
+  void setClock(uint32_t) {}
+  void setSpeed(uint32_t) {}
+  void beginTransmission(uint8_t address);
+  void beginTransmission(int address) { beginTransmission((uint8_t) address); }
+  void beginTransmission(const WireTransmission &t) { beginTransmission(t.address_); }
+  uint8_t endTransmission(bool stop = true);
+  size_t requestFrom(uint8_t address, size_t n, uint8_t stop = 1);
+  size_t requestFrom(int address, int n) { return requestFrom((uint8_t) address, (size_t) n); }
+  size_t requestFrom(int address, int n, int stop) { return requestFrom((uint8_t) address, (size_t) n, (uint8_t) stop); }
+  size_t requestFrom(const WireTransmission &t) { return requestFrom(t.address_, t.quantity_, (uint8_t) t.stop_); }
+  size_t write(uint8_t c);
+  size_t write(const uint8_t *buf, size_t n) { for (size_t i=0; i<n; i++) write(buf[i]); return n; }
+  using Print::write;
+  int available() { return (int) (rx_n_ - rx_i_); }
+  int read() { return (rx_i_ < rx_n_) ? rx_[rx_i_++] : -1; }
+  int peek() { return (rx_i_ < rx_n_) ? rx_[rx_i_] : -1; }
+private:
+  bool enabled_ = false;
+  uint8_t tx_address_ = 0;
+  uint8_t tx_[64];
+  size_t tx_n_ = 0;
+  uint8_t rx_[64];
+  size_t rx_n_ = 0;
+  size_t rx_i_ = 0;
+};
+extern TwoWire Wire;
+
+/*
+ * ======================================================================================================================
+ *  SPI - Nothing is on the SPI bus but the SD card, which SdFat.h models
+ * ======================================================================================================================
+ */
+class SPISettings {
+public:
+  SPISettings() {}
+  SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass {
+public:
+  void begin() {}
+  void begin(uint16_t) {}
+  void end() {}
+  void beginTransaction(SPISettings) {}
+  void endTransaction() {}
+  uint8_t transfer(uint8_t) { return 0xFF; }
+  void transfer(void *, void *, size_t, void *) {}
+  void transfer(void *, size_t) {}
+  void setBitOrder(uint8_t) {}
+  void setDataMode(uint8_t) {}
+  void setClockDivider(uint8_t) {}
+  void setClockSpeed(uint32_t) {}
+};
+extern SPIClass SPI;
+
+/*
+ * ======================================================================================================================
+ *  Wiring functions
+ * ======================================================================================================================
+ */
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+unsigned long millis();
+unsigned long micros();
+int32_t analogRead(uint16_t pin);
+void analogWrite(uint16_t pin, int value);
+void pinMode(uint16_t pin, int mode);
+int32_t digitalRead(uint16_t pin);
+void digitalWrite(uint16_t pin, uint8_t value);
+inline void pinResetFast(uint16_t pin) { digitalWrite(pin, LOW); }
+inline void pinSetFast(uint16_t pin) { digitalWrite(pin, HIGH); }
+inline void yield() {}
+
+/*
+ * ======================================================================================================================
+ *  System
+ * ======================================================================================================================
+ */
+typedef int system_event_t;
+enum class SystemSleepMode { STOP, ULTRA_LOW_POWER, HIBERNATE };
+enum network_interface_t { NETWORK_INTERFACE_ALL = 0, NETWORK_INTERFACE_CELLULAR = 1, NETWORK_INTERFACE_WIFI_STA = 2 };
+enum class SystemSleepWakeupReason { UNKNOWN, BY_GPIO, BY_ADC, BY_DAC, BY_RTC, BY_NETWORK, BY_BLE, BY_NFC, BY_LPCOMP,
+  BY_USART, BY_CAN };
+enum { BATTERY_STATE_UNKNOWN = 0, BATTERY_STATE_NOT_CHARGING, BATTERY_STATE_CHARGING, BATTERY_STATE_CHARGED,
+  BATTERY_STATE_DISCHARGING, BATTERY_STATE_FAULT, BATTERY_STATE_DISCONNECTED };
+
+class SystemSleepConfiguration {
+public:
+  SystemSleepConfiguration &mode(SystemSleepMode m) { mode_ = m; return *this; }
+  SystemSleepConfiguration &duration(uint32_t ms) { duration_ = ms; return *this; }
+  SystemSleepConfiguration &network(network_interface_t n) { network_ = n; return *this; }
+  SystemSleepConfiguration &gpio(uint16_t, int) { return *this; }
+  SystemSleepMode mode_ = SystemSleepMode::STOP;
+  uint32_t duration_ = 0;
+  int network_ = -1;
+};
+
+class SystemSleepResult {
+public:
+  SystemSleepResult(SystemSleepWakeupReason r = SystemSleepWakeupReason::UNKNOWN) : reason_(r) {}
+  SystemSleepWakeupReason wakeupReason() const { return reason_; }
+private:
+  SystemSleepWakeupReason reason_;
+};
+
+class SystemClass {
+public:
+  uint64_t millis();
+  uint32_t uptime();
+  SystemSleepResult sleep(const SystemSleepConfiguration &config);
+  int batteryState();
+  float batteryCharge();
+  int powerSource() { return 5; }        // POWER_SOURCE_BATTERY
+  String deviceID() { return String("e00fce68000000000000sim"); }
+  String version() { return String("6.3.3"); }
+  uint32_t freeMemory() { return 80000; }
+  void on(int, void (*)(system_event_t, int)) {}
+  void reset();
+};
+extern SystemClass System;
+
+/*
+ * ======================================================================================================================
+ *  Time - System Time Clock, valid once set from the RTC or synced by the cloud connection
+ * ======================================================================================================================
+ */
+class TimeClass {
+public:
+  time32_t now();
+  bool isValid();
+  void setTime(time_t t);
+  void setFormat(int) {}
+  int year() { return year(now()); }
+  int month() { return month(now()); }
+  int day() { return day(now()); }
+  int hour() { return hour(now()); }
+  int minute() { return minute(now()); }
+  int second() { return second(now()); }
+  int year(time_t t) { return tm_(t).tm_year + 1900; }
+  int month(time_t t) { return tm_(t).tm_mon + 1; }
+  int day(time_t t) { return tm_(t).tm_mday; }
+  int hour(time_t t) { return tm_(t).tm_hour; }
+  int minute(time_t t) { return tm_(t).tm_min; }
+  int second(time_t t) { return tm_(t).tm_sec; }
+private:
+  struct tm tm_(time_t t) { struct tm r; gmtime_r(&t, &r); return r; }
+};
+extern TimeClass Time;
+
+/*
+ * ======================================================================================================================
+ *  Cloud, Cellular, WiFi
+ * ======================================================================================================================
+ */
+class CloudClass {
+public:
+  static int maxEventDataSize() { return 1024; }
+  bool connected();
+  static bool disconnected();
+  void connect();
+  void disconnect();
+  bool publish(const char *name, const char *data, int flags = PRIVATE);
+};
+extern CloudClass Particle;
+
+bool sim_wait_for(bool (*fn)(), uint32_t ms);
+#define waitFor(fn, ms) sim_wait_for([]() -> bool { return fn(); }, ms)
+
+class CellularSignal {
+public:
+  float getStrength() { return 62.5; }
+  float getQuality() { return 48.4; }
+};
+
+enum SimType { INTERNAL_SIM = 1, EXTERNAL_SIM = 2 };
+
+class CellularClass {
+public:
+  void on();
+  void off();
+  void connect();
+  void disconnect();
+  bool ready();
+  CellularSignal RSSI() { return CellularSignal(); }
+  SimType getActiveSim() { return INTERNAL_SIM; }
+  void setActiveSim(SimType) {}
+  void clearCredentials() {}
+  void setCredentials(const char *) {}
+  void setCredentials(const char *, const char *) {}
+  void setCredentials(const char *, const char *, const char *) {}
+};
+extern CellularClass Cellular;
+
+class IPAddress {
+public:
+  String toString() { return String("10.0.0.2"); }
+};
+
+class WiFiSignal {
+public:
+  float getStrength() { return 70.0; }
+  float getQuality() { return 55.0; }
+};
+
+class WiFiClass {
+public:
+  void on();
+  void off();
+  void connect();
+  void disconnect();
+  bool ready();
+  WiFiSignal RSSI() { return WiFiSignal(); }
+  void clearCredentials() {}
+  void setCredentials(const char *, const char *, int) {}
+  void setCredentials(const char *) {}
+  void macAddress(byte *m) { memset(m, 0, 6); }
+  void BSSID(byte *m) { memset(m, 0, 6); }
+  IPAddress localIP() { return IPAddress(); }
+  IPAddress subnetMask() { return IPAddress(); }
+  IPAddress gatewayIP() { return IPAddress(); }
+  IPAddress dnsServerIP() { return IPAddress(); }
+  IPAddress dhcpServerIP() { return IPAddress(); }
+  const char *SSID() { return "sgsim"; }
+};
+extern WiFiClass WiFi;
+
+/*
+ * ======================================================================================================================
+ *  PMIC, EEPROM, Timer
+ * ======================================================================================================================
+ */
+class PMIC {
+public:
+  void enableBATFET() {}
+  void disableBATFET() {}
+  bool isPowerGood();
+  byte getFault() { return 0; }
+};
+
+class EEPROMClass {
+public:
+  template <class T> T &get(int address, T &t) { memcpy(&t, &data_[address], sizeof(T)); return t; }
+  template <class T> const T &put(int address, const T &t) { memcpy(&data_[address], &t, sizeof(T)); puts_++; return t; }
+  size_t length() { return sizeof(data_); }
+  uint32_t puts_ = 0;                     // Writes, each one wears flash on the device
+private:
+  uint8_t data_[4096] = {};
+};
+extern EEPROMClass EEPROM;
+
+class Timer {
+public:
+  typedef void (*timer_callback_fn)(void);
+  Timer(unsigned period, timer_callback_fn fn, bool one_shot = false);
+  ~Timer();
+  bool start();
+  bool stop();
+  bool reset() { return start(); }
+  bool isActive() { return active_; }
+  bool changePeriod(unsigned period) { period_ = period; return start(); }
+  unsigned period_;
+  timer_callback_fn fn_;
+  bool one_shot_;
+  bool active_ = false;
+  uint64_t due_us_ = 0;
+};
@@ -0,0 +1,72 @@
+/*
+ * ======================================================================================================================
+ *  SdFat.h - Host stand-in for SdFat, the card is a directory on the host, see Sim::cfg.sd_dir
+ * ======================================================================================================================
+ */
+#pragma once
+
+#include "Particle.h"
+#include <memory>
+
+// SdFat's open flags, not the host's
+#undef O_RDONLY
+#undef O_WRONLY
+#undef O_RDWR
+#undef O_AT_END
+#undef O_APPEND
+#undef O_CREAT
+#undef O_TRUNC
+#undef O_EXCL
+#define O_RDONLY  0X00
+#define O_WRONLY  0X01
+#define O_RDWR    0X02
+#define O_AT_END  0X04
+#define O_APPEND  0X08
+#define O_CREAT   0x10
+#define O_TRUNC   0x20
+#define O_EXCL    0x40
+#define O_READ    O_RDONLY
+#define O_WRITE   O_WRONLY
+#define FILE_READ O_RDONLY
+#define FILE_WRITE (O_RDWR | O_CREAT | O_AT_END)
+
+class File : public Stream {
+public:
+  File() {}
+  operator bool() const { return fp_ != nullptr; }
+  bool isOpen() const { return fp_ != nullptr; }
+  bool open(const char *path, int oflag);
+  void close();
+  bool sync();
+  uint32_t size();
+  uint32_t fileSize() { return size(); }
+  bool seek(uint32_t pos);
+  bool seekSet(uint32_t pos) { return seek(pos); }
+  uint32_t position();
+  uint32_t curPosition() { return position(); }
+  int available();
+  int read();
+  int read(void *buf, size_t n);
+  int peek();
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t write(const void *buf, size_t n);
+  size_t write(const uint8_t *buf, size_t n) { return write((const void *) buf, n); }
+  using Print::write;
+  bool rename(const char *path);
+  bool truncate(uint32_t length);
+  bool createContiguous(const char *path, uint32_t size);
+private:
+  std::shared_ptr<FILE> fp_;
+  std::string path_;
+  int oflag_ = 0;
+};
+
+class SdFat {
+public:
+  bool begin(uint8_t cs);
+  bool exists(const char *path);
+  bool mkdir(const char *path);
+  bool remove(const char *path);
+  bool rename(const char *from, const char *to);
+  File open(const char *path, int oflag = FILE_READ);
+};
@@ -0,0 +1,752 @@
+/*
+ * ======================================================================================================================
+ *  Sim.cpp - Virtual clock, modeled hardware and the Particle.h stand-in behind it
+ * ======================================================================================================================
+ */
+#include "Sim.h"
+#include "SdFat.h"
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+USBSerial Serial;
+TwoWire Wire;
+SPIClass SPI;
+SystemClass System;
+TimeClass Time;
+CloudClass Particle;
+CellularClass Cellular;
+WiFiClass WiFi;
+EEPROMClass EEPROM;
+
+namespace Sim {
+  Config cfg;
+  Counters counters[SIM_PHASES];
+  Counters slept[SIM_PHASES];
+  int (*phase_fn)() = nullptr;
+  std::vector<Event> events;
+  uint64_t now_us = 0;
+  uint32_t sleeps = 0;
+}
+
+/*
+ * ======================================================================================================================
+ *  Clock and Timers
+ * ======================================================================================================================
+ */
+// Firmware Timers are globals constructed before ours, so the list is made on first use
+static std::vector<Timer *> &sim_timers() {
+  static std::vector<Timer *> timers;
+  return timers;
+}
+
+static bool in_timer = false;
+static bool sleeping = false;
+
+void Sim::advance(uint64_t us) {
+  uint64_t end = now_us + us;
+
+  // Fire what comes due on the way, in order. Not while asleep, the sampler is stopped before we sleep anyway.
+  while (!in_timer && !sleeping) {
+    Timer *next = nullptr;
+    for (Timer *t : sim_timers()) {
+      if (t->active_ && (t->due_us_ <= end) && (!next || (t->due_us_ < next->due_us_))) {
+        next = t;
+      }
+    }
+    if (!next) {
+      break;
+    }
+    if (next->due_us_ > now_us) {
+      now_us = next->due_us_;
+    }
+    if (next->one_shot_) {
+      next->active_ = false;
+    }
+    else {
+      next->due_us_ += (uint64_t) next->period_ * 1000;
+    }
+    in_timer = true;
+    next->fn_();
+    in_timer = false;
+  }
+  if (end > now_us) {
+    now_us = end;
+  }
+}
+
+time_t Sim::wall() {
+  return cfg.start + (time_t) (now_us / 1000000);
+}
+
+Sim::Counters &Sim::counter() {
+  int p = (phase_fn) ? phase_fn() : 0;
+  return (counters[(p >= 0 && p < SIM_PHASES) ? p : 0]);
+}
+
+Sim::Counters Sim::total(Counters *c) {
+  Counters t = {};
+
+  for (int i=0; i<SIM_PHASES; i++) {
+    t.delays += c[i].delays;
+    t.delay_ms += c[i].delay_ms;
+    t.sd_bytes += c[i].sd_bytes;
+    t.pub_count += c[i].pub_count;
+    t.pub_bytes += c[i].pub_bytes;
+    t.i2c += c[i].i2c;
+  }
+  return t;
+}
+
+void Sim::clear() {
+  memset(counters, 0, sizeof(counters));
+  memset(slept, 0, sizeof(slept));
+  events.clear();
+  sleeps = 0;
+}
+
+bool Sim::cycle(void (*loop_fn)()) {
+  uint32_t n = sleeps;
+  uint64_t start = now_us;
+
+  memset(slept, 0, sizeof(slept));
+  while (sleeps == n) {
+    loop_fn();
+    if (now_us - start > 24ULL*3600*1000000) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Timer::Timer(unsigned period, timer_callback_fn fn, bool one_shot) : period_(period), fn_(fn), one_shot_(one_shot) {
+  sim_timers().push_back(this);
+}
+
+Timer::~Timer() {
+  std::vector<Timer *> &timers = sim_timers();
+
+  for (size_t i=0; i<timers.size(); i++) {
+    if (timers[i] == this) {
+      timers.erase(timers.begin() + i);
+      break;
+    }
+  }
+}
+
+bool Timer::start() {
+  active_ = true;
+  due_us_ = Sim::now_us + (uint64_t) period_ * 1000;
+  return true;
+}
+
+bool Timer::stop() {
+  active_ = false;
+  return true;
+}
+
+void delay(unsigned long ms) {
+  Sim::Counters &c = Sim::counter();
+  c.delays++;
+  c.delay_ms += ms;
+  Sim::advance((uint64_t) ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+  Sim::advance(us);
+}
+
+unsigned long millis() {
+  Sim::advance(SIM_POLL_US);
+  return (unsigned long) (Sim::now_us / 1000);
+}
+
+unsigned long micros() {
+  Sim::advance(SIM_POLL_US);
+  return (unsigned long) Sim::now_us;
+}
+
+bool sim_wait_for(bool (*fn)(), uint32_t ms) {
+  uint64_t end = Sim::now_us + (uint64_t) ms * 1000;
+
+  while (!fn()) {
+    if (Sim::now_us >= end) {
+      return false;
+    }
+    Sim::advance(1000);
+  }
+  return true;
+}
+
+/*
+ * ======================================================================================================================
+ *  Pins - SCE jumper off, distance gauge on A3
+ * ======================================================================================================================
+ */
+static uint32_t noise_state = 1;
+
+int32_t analogRead(uint16_t pin) {
+  Sim::advance(10);
+  if (pin == A3) {
+    noise_state = noise_state * 1103515245 + 12345;
+    int n = (Sim::cfg.noise) ? (int) ((noise_state >> 16) % (2 * Sim::cfg.noise + 1)) - Sim::cfg.noise : 0;
+    int d = Sim::cfg.distance + (int) (Sim::cfg.ramp * (Sim::now_us / 60000000.0));
+    return constrain(d + n, 0, 4095);
+  }
+  if (pin == BATT) {
+    return 3700;
+  }
+  return 0;
+}
+
+void analogWrite(uint16_t, int) {}
+void pinMode(uint16_t, int) {}
+void digitalWrite(uint16_t, uint8_t) {}
+
+int32_t digitalRead(uint16_t pin) {
+  return HIGH;  // SCE jumper off, PWR and CHG high, SDA released
+}
+
+size_t USBSerial::write(uint8_t c) {
+  if (Sim::cfg.verbose && (c != '\r')) {
+    putchar(c);
+  }
+  return 1;
+}
+
+/*
+ * ======================================================================================================================
+ *  I2C Devices
+ * ======================================================================================================================
+ */
+struct SimDevice {
+  uint8_t address;
+  virtual ~SimDevice() {}
+  virtual void write(const uint8_t *buf, size_t n) = 0;
+  virtual size_t read(uint8_t *buf, size_t n) = 0;
+};
+
+static uint8_t bcd(int v) { return (uint8_t) (((v / 10) << 4) | (v % 10)); }
+static int unbcd(uint8_t v) { return ((v >> 4) * 10) + (v & 0xF); }
+
+// PCF8523 - Time registers 0x03 to 0x09 in BCD, kept as an offset from the true time
+struct SimPCF8523 : SimDevice {
+  long offset = 0;
+  uint8_t reg = 0;
+  uint8_t regs[20] = {};
+
+  void write(const uint8_t *buf, size_t n) {
+    if (!n) {
+      return;
+    }
+    reg = buf[0];
+    for (size_t i=1; i<n; i++, reg++) {
+      if (reg < sizeof(regs)) {
+        regs[reg] = buf[i];
+      }
+      if (reg == 0x09) {
+        struct tm t = {};
+        t.tm_sec = unbcd(regs[3] & 0x7F);
+        t.tm_min = unbcd(regs[4]);
+        t.tm_hour = unbcd(regs[5]);
+        t.tm_mday = unbcd(regs[6]);
+        t.tm_mon = unbcd(regs[8]) - 1;
+        t.tm_year = unbcd(regs[9]) + 100;
+        offset = (long) (timegm(&t) - Sim::wall());
+      }
+    }
+  }
+
+  size_t read(uint8_t *buf, size_t n) {
+    time_t now = Sim::wall() + offset;
+    struct tm t;
+    gmtime_r(&now, &t);
+    regs[3] = bcd(t.tm_sec);
+    regs[4] = bcd(t.tm_min);
+    regs[5] = bcd(t.tm_hour);
+    regs[6] = bcd(t.tm_mday);
+    regs[7] = bcd(t.tm_wday);
+    regs[8] = bcd(t.tm_mon + 1);
+    regs[9] = bcd((t.tm_year + 1900) % 100);
+    for (size_t i=0; i<n; i++, reg++) {
+      buf[i] = (reg < sizeof(regs)) ? regs[reg] : 0;
+    }
+    return n;
+  }
+};
+
+// MCP9808 - 16 bit big endian registers
+struct SimMCP9808 : SimDevice {
+  uint8_t reg = 0;
+  uint16_t regs[16] = {0, 0, 0, 0, 0, 0, 0x0054, 0x0400, 0x03};
+
+  SimMCP9808() {
+    regs[5] = (uint16_t) (18.25 * 16);   // Ambient 18.25C
+  }
+
+  void write(const uint8_t *buf, size_t n) {
+    if (n) {
+      reg = buf[0] & 0x0F;
+    }
+    if (n >= 3) {
+      regs[reg] = (uint16_t) ((buf[1] << 8) | buf[2]);
+    }
+  }
+
+  size_t read(uint8_t *buf, size_t n) {
+    uint8_t b[2] = {(uint8_t) (regs[reg] >> 8), (uint8_t) regs[reg]};
+    if (reg == 8) {
+      b[0] = (uint8_t) regs[reg];
+    }
+    for (size_t i=0; i<n; i++) {
+      buf[i] = b[i & 1];
+    }
+    return n;
+  }
+};
+
+// HIH8000 - A probe starts a measurement, a 4 byte read returns humidity and temperature
+struct SimHIH8000 : SimDevice {
+  void write(const uint8_t *, size_t) {}
+
+  size_t read(uint8_t *buf, size_t n) {
+    uint16_t h = (uint16_t) (62.5 / 6.10e-3);           // 62.5%
+    uint16_t t = (uint16_t) ((18.5 + 40.0) / 1.007e-2); // 18.5C
+    uint8_t b[4] = {(uint8_t) (h >> 8), (uint8_t) h, (uint8_t) (t >> 6), (uint8_t) (t << 2)};
+    for (size_t i=0; i<n; i++) {
+      buf[i] = (i < 4) ? b[i] : 0;
+    }
+    return n;
+  }
+};
+
+// SSD1306 - Takes commands and display data, nothing to read
+struct SimSSD1306 : SimDevice {
+  void write(const uint8_t *, size_t) {}
+  size_t read(uint8_t *buf, size_t n) { memset(buf, 0, n); return n; }
+};
+
+static SimPCF8523 pcf8523;
+static SimMCP9808 mcp9808;
+static SimHIH8000 hih8000;
+static SimSSD1306 ssd1306;
+
+static SimDevice *i2c_device(uint8_t address) {
+  static bool first = true;
+
+  if (first) {
+    first = false;
+    // Power on, a cold RTC reads back as 2000-01-01
+    pcf8523.offset = (Sim::cfg.rtc_set) ? 0 : (long) (946684800 - Sim::wall());
+  }
+  switch (address) {
+    case 0x68 : return (Sim::cfg.rtc) ? &pcf8523 : nullptr;
+    case 0x18 : return (Sim::cfg.sensors) ? &mcp9808 : nullptr;
+    case 0x27 : return (Sim::cfg.sensors) ? &hih8000 : nullptr;
+    case 0x3C : return (Sim::cfg.oled) ? &ssd1306 : nullptr;
+    default   : return nullptr;
+  }
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  tx_address_ = address;
+  tx_n_ = 0;
+}
+
+size_t TwoWire::write(uint8_t c) {
+  if (tx_n_ < sizeof(tx_)) {
+    tx_[tx_n_++] = c;
+    return 1;
+  }
+  return 0;
+}
+
+// Return codes follow the Device OS table, an address that is not acknowledged ends with 3
+uint8_t TwoWire::endTransmission(bool) {
+  SimDevice *d = i2c_device(tx_address_);
+
+  Sim::counter().i2c++;
+  Sim::advance((1 + (d ? tx_n_ : 0)) * SIM_I2C_BYTE_US);
+  if (!d) {
+    return 3;
+  }
+  d->write(tx_, tx_n_);
+  return 0;
+}
+
+size_t TwoWire::requestFrom(uint8_t address, size_t n, uint8_t) {
+  SimDevice *d = i2c_device(address);
+
+  Sim::counter().i2c++;
+  rx_n_ = 0;
+  rx_i_ = 0;
+  n = min(n, sizeof(rx_));
+  Sim::advance((1 + (d ? n : 0)) * SIM_I2C_BYTE_US);
+  if (d) {
+    rx_n_ = d->read(rx_, n);
+  }
+  return rx_n_;
+}
+
+/*
+ * ======================================================================================================================
+ *  System and Time
+ * ======================================================================================================================
+ */
+static bool stc_valid = false;
+static long stc_offset = 0;             // System time clock less the true time
+
+uint64_t SystemClass::millis() {
+  Sim::advance(SIM_POLL_US);
+  return Sim::now_us / 1000;
+}
+
+uint32_t SystemClass::uptime() {
+  return (uint32_t) (Sim::now_us / 1000000);
+}
+
+int SystemClass::batteryState() {
+  return (Sim::cfg.power_good) ? BATTERY_STATE_CHARGING : BATTERY_STATE_DISCHARGING;
+}
+
+float SystemClass::batteryCharge() {
+  return Sim::cfg.battery;
+}
+
+void SystemClass::reset() {
+  throw Sim::Reset();
+}
+
+bool PMIC::isPowerGood() {
+  return Sim::cfg.power_good;
+}
+
+time32_t TimeClass::now() {
+  return (time32_t) (Sim::wall() + stc_offset);
+}
+
+bool TimeClass::isValid() {
+  return stc_valid;
+}
+
+void TimeClass::setTime(time_t t) {
+  stc_offset = (long) (t - Sim::wall());
+  stc_valid = true;
+}
+
+/*
+ * ======================================================================================================================
+ *  Modem and Cloud
+ *
+ *  The network is ready net_ms after the modem is told to connect, the cloud session cloud_ms after that and
+ *  Particle.connect(). Connecting syncs the system time clock, as Device OS does.
+ * ======================================================================================================================
+ */
+static bool modem_on = false;
+static bool net_connecting = false;
+static uint64_t net_start_us = 0;
+static bool cloud_connecting = false;
+static uint64_t cloud_start_us = 0;
+static bool cloud_up = false;
+
+static bool net_ready() {
+  return modem_on && net_connecting && !Sim::cfg.net_fail &&
+         (Sim::now_us >= net_start_us + (uint64_t) Sim::cfg.net_ms * 1000);
+}
+
+static bool cloud_ready() {
+  if (!cloud_up && cloud_connecting && net_ready()) {
+    uint64_t from = max(cloud_start_us, net_start_us + (uint64_t) Sim::cfg.net_ms * 1000);
+    if (Sim::now_us >= from + (uint64_t) Sim::cfg.cloud_ms * 1000) {
+      cloud_up = true;
+      Time.setTime(Sim::wall());
+    }
+  }
+  return cloud_up && net_ready();
+}
+
+static void modem(bool on) {
+  modem_on = on;
+  if (!on) {
+    net_connecting = false;
+    cloud_connecting = false;
+    cloud_up = false;
+  }
+}
+
+static void net_connect() {
+  if (!net_connecting) {
+    net_connecting = true;
+    net_start_us = Sim::now_us;
+  }
+}
+
+static void net_disconnect() {
+  net_connecting = false;
+  cloud_connecting = false;
+  cloud_up = false;
+}
+
+void CellularClass::on() { modem(true); }
+void CellularClass::off() { modem(false); }
+void CellularClass::connect() { modem(true); net_connect(); }
+void CellularClass::disconnect() { net_disconnect(); }
+bool CellularClass::ready() { return net_ready(); }
+void WiFiClass::on() { modem(true); }
+void WiFiClass::off() { modem(false); }
+void WiFiClass::connect() { modem(true); net_connect(); }
+void WiFiClass::disconnect() { net_disconnect(); }
+bool WiFiClass::ready() { return net_ready(); }
+
+bool CloudClass::connected() {
+  return cloud_ready();
+}
+
+bool CloudClass::disconnected() {
+  return !cloud_ready();
+}
+
+void CloudClass::connect() {
+  if (!cloud_connecting) {
+    cloud_connecting = true;
+    cloud_start_us = Sim::now_us;
+  }
+}
+
+void CloudClass::disconnect() {
+  cloud_connecting = false;
+  cloud_up = false;
+}
+
+bool CloudClass::publish(const char *name, const char *data, int) {
+  if (!cloud_ready()) {
+    return false;
+  }
+  Sim::advance((uint64_t) Sim::cfg.publish_ms * 1000);
+  if (Sim::cfg.publish_fail) {
+    return false;
+  }
+  Sim::Counters &c = Sim::counter();
+  c.pub_count++;
+  c.pub_bytes += strlen(name) + strlen(data);
+  Sim::events.push_back({Sim::now_us / 1000, name, data});
+  if (Sim::cfg.verbose) {
+    printf("[PUB %s] %s\n", name, data);
+  }
+  return true;
+}
+
+/*
+ * ======================================================================================================================
+ *  Sleep - ULTRA_LOW_POWER for the duration, or until network activity when the modem is left on
+ * ======================================================================================================================
+ */
+SystemSleepResult SystemClass::sleep(const SystemSleepConfiguration &config) {
+  SystemSleepWakeupReason reason = SystemSleepWakeupReason::BY_RTC;
+  uint64_t ms = config.duration_;
+
+  Sim::sleeps++;
+  for (int i=0; i<SIM_PHASES; i++) {
+    Sim::Counters &c = Sim::counters[i], &s = Sim::slept[i];
+    s.delays += c.delays;
+    s.delay_ms += c.delay_ms;
+    s.sd_bytes += c.sd_bytes;
+    s.pub_count += c.pub_count;
+    s.pub_bytes += c.pub_bytes;
+    s.i2c += c.i2c;
+  }
+  memset(Sim::counters, 0, sizeof(Sim::counters));
+  if ((config.network_ >= 0) && Sim::cfg.network_wake_ms && (ms > Sim::cfg.network_wake_ms)) {
+    ms = Sim::cfg.network_wake_ms;
+    reason = SystemSleepWakeupReason::BY_NETWORK;
+  }
+  if (config.network_ < 0) {
+    modem(false);  // The modem is not kept on through the sleep
+  }
+  sleeping = true;
+  Sim::advance(ms * 1000);
+  sleeping = false;
+
+  // Timers do not run while asleep, pick up where they left off
+  for (Timer *t : sim_timers()) {
+    if (t->active_ && (t->due_us_ < Sim::now_us)) {
+      t->due_us_ = Sim::now_us + (uint64_t) t->period_ * 1000;
+    }
+  }
+  if (Sim::cfg.verbose) {
+    printf("[SLEEP %llums %s]\n", (unsigned long long) ms,
+      (reason == SystemSleepWakeupReason::BY_RTC) ? "RTC" : "NETWORK");
+  }
+  return SystemSleepResult(reason);
+}
+
+/*
+ * ======================================================================================================================
+ *  SD Card
+ * ======================================================================================================================
+ */
+static std::string sd_path(const char *path) {
+  while (*path == '/') {
+    path++;
+  }
+  return Sim::cfg.sd_dir + "/" + path;
+}
+
+bool SdFat::begin(uint8_t) {
+  if (!Sim::cfg.sd) {
+    return false;
+  }
+  ::mkdir(Sim::cfg.sd_dir.c_str(), 0755);
+  Sim::advance(SIM_SD_OPEN_US);
+  return true;
+}
+
+bool SdFat::exists(const char *path) {
+  struct stat st;
+  Sim::advance(SIM_SD_OPEN_US);
+  return (stat(sd_path(path).c_str(), &st) == 0);
+}
+
+bool SdFat::mkdir(const char *path) {
+  Sim::advance(SIM_SD_OPEN_US);
+  return (::mkdir(sd_path(path).c_str(), 0755) == 0);
+}
+
+bool SdFat::remove(const char *path) {
+  Sim::advance(SIM_SD_OPEN_US);
+  return (::remove(sd_path(path).c_str()) == 0);
+}
+
+bool SdFat::rename(const char *from, const char *to) {
+  Sim::advance(SIM_SD_OPEN_US);
+  return (::rename(sd_path(from).c_str(), sd_path(to).c_str()) == 0);
+}
+
+File SdFat::open(const char *path, int oflag) {
+  File f;
+  f.open(path, oflag);
+  return f;
+}
+
+bool File::open(const char *path, int oflag) {
+  struct stat st;
+  std::string p = sd_path(path);
+  bool exists = (stat(p.c_str(), &st) == 0);
+  const char *mode;
+
+  Sim::advance(SIM_SD_OPEN_US);
+  close();
+  if (exists && S_ISDIR(st.st_mode)) {
+    return false;
+  }
+  if (!exists && !(oflag & O_CREAT)) {
+    return false;
+  }
+  if (exists && (oflag & O_CREAT) && (oflag & O_EXCL)) {
+    return false;
+  }
+  if ((oflag & 0x03) == O_RDONLY) {
+    mode = "rb";
+  }
+  else if (!exists || (oflag & O_TRUNC)) {
+    mode = "w+b";
+  }
+  else {
+    mode = "r+b";
+  }
+
+  FILE *fp = fopen(p.c_str(), mode);
+  if (!fp) {
+    return false;
+  }
+  fp_ = std::shared_ptr<FILE>(fp, fclose);
+  path_ = path;
+  oflag_ = oflag;
+  if (oflag & O_AT_END) {
+    fseek(fp, 0, SEEK_END);
+  }
+  return true;
+}
+
+void File::close() {
+  fp_.reset();
+}
+
+bool File::sync() {
+  return fp_ && (fflush(fp_.get()) == 0);
+}
+
+uint32_t File::size() {
+  if (!fp_) {
+    return 0;
+  }
+  long pos = ftell(fp_.get());
+  fseek(fp_.get(), 0, SEEK_END);
+  long n = ftell(fp_.get());
+  fseek(fp_.get(), pos, SEEK_SET);
+  return (uint32_t) n;
+}
+
+bool File::seek(uint32_t pos) {
+  return fp_ && (pos <= size()) && (fseek(fp_.get(), pos, SEEK_SET) == 0);
+}
+
+uint32_t File::position() {
+  return (fp_) ? (uint32_t) ftell(fp_.get()) : 0;
+}
+
+int File::available() {
+  return (fp_) ? (int) (size() - position()) : 0;
+}
+
+int File::read() {
+  uint8_t c;
+  return (read(&c, 1) == 1) ? c : -1;
+}
+
+int File::peek() {
+  int c = read();
+  if (c >= 0) {
+    fseek(fp_.get(), -1, SEEK_CUR);
+  }
+  return c;
+}
+
+int File::read(void *buf, size_t n) {
+  if (!fp_) {
+    return -1;
+  }
+  fseek(fp_.get(), 0, SEEK_CUR);  // Switching from writing to reading
+  Sim::advance(n * SIM_SD_BYTE_US);
+  return (int) fread(buf, 1, n, fp_.get());
+}
+
+size_t File::write(const void *buf, size_t n) {
+  if (!fp_ || ((oflag_ & 0x03) == O_RDONLY)) {
+    return 0;
+  }
+  fseek(fp_.get(), 0, (oflag_ & O_APPEND) ? SEEK_END : SEEK_CUR);
+  Sim::advance(SIM_SD_WRITE_US + n * SIM_SD_BYTE_US);
+  Sim::counter().sd_bytes += n;
+  return fwrite(buf, 1, n, fp_.get());
+}
+
+bool File::rename(const char *path) {
+  if (!fp_ || (::rename(sd_path(path_.c_str()).c_str(), sd_path(path).c_str()) != 0)) {
+    return false;
+  }
+  path_ = path;
+  return true;
+}
+
+bool File::truncate(uint32_t length) {
+  return fp_ && (fflush(fp_.get()) == 0) && (ftruncate(fileno(fp_.get()), length) == 0);
+}
+
+bool File::createContiguous(const char *path, uint32_t size) {
+  if (!open(path, O_RDWR | O_CREAT | O_EXCL)) {
+    return false;
+  }
+  Sim::advance(SIM_SD_WRITE_US);  // Cluster allocation, the FAT entries written once
+  return truncate(size);
+}
@@ -0,0 +1,85 @@
+/*
+ * ======================================================================================================================
+ *  Sim.h - Virtual clock, modeled hardware and counters behind the Particle.h stand-in
+ *
+ *  Nothing takes host time. The clock only moves when the firmware waits: delay(), waitFor(), System.sleep(),
+ *  and the modeled cost of I2C transfers, SD card access and publishes. Each millis() or micros() call also costs
+ *  SIM_POLL_US so a loop polling the clock always gets somewhere. Awake time measured this way is the time the
+ *  firmware spends waiting on purpose or on hardware, which is what the battery pays for.
+ *
+ *  Counters are kept per PERF phase, Sim::phase_fn is set by the harness to read perf_phase. They are moved to
+ *  Sim::slept when the firmware goes to sleep, so a cycle's counters run from one wake to the next sleep. A cycle
+ *  is one pass of loop() that sleeps, a wake that goes straight back to sleep is part of it.
+ * ======================================================================================================================
+ */
+#pragma once
+
+#include "Particle.h"
+#include <string>
+#include <vector>
+
+#define SIM_POLL_US       2             // Cost of one millis(), micros() or System.millis() call
+#define SIM_I2C_BYTE_US   90            // One byte with its ACK at 100kHz
+#define SIM_SD_OPEN_US    3000          // Directory search and FAT reads to open a file
+#define SIM_SD_WRITE_US   1500          // One write, the sector read, modify and write
+#define SIM_SD_BYTE_US    2             // Per byte written or read
+#define SIM_PHASES        16
+
+namespace Sim {
+
+  // Scenario, set before setup() runs
+  struct Config {
+    time_t start = 1791158400;          // Wall clock at power on, 2026-10-05T00:00:00Z
+    bool rtc = true;                    // PCF8523 on the bus
+    bool rtc_set = true;                // and it holds the time
+    bool sensors = true;                // MCP9808 and HIH8000 on the bus
+    bool oled = false;                  // SSD1306 128x32 on the bus
+    bool sd = true;                     // SD card in the slot
+    std::string sd_dir = "sgsim.sd";    // Host directory that is the card
+    uint32_t net_ms = 12000;            // Modem on to network ready
+    uint32_t cloud_ms = 3000;           // Particle.connect() to connected
+    bool net_fail = false;              // Network never attaches
+    uint32_t publish_ms = 400;          // Publish with ACK round trip
+    bool publish_fail = false;          // Publishes are not acknowledged
+    uint32_t network_wake_ms = 0;       // Wake a sleep with the network on after this long, 0 never
+    int distance = 1200;                // Distance gauge ADC counts
+    float ramp = 0.0;                   // ADC counts per minute the distance changes by
+    int noise = 3;                      // +- ADC counts of noise
+    float battery = 86.0;               // Percent charge
+    bool power_good = true;             // On USB or solar
+    bool verbose = false;               // Serial console to stdout
+  };
+  extern Config cfg;
+
+  // Counted per PERF phase
+  struct Counters {
+    uint32_t delays;                    // Blocking delay() calls
+    uint64_t delay_ms;                  // Milliseconds in them
+    uint32_t sd_bytes;                  // Bytes written to the card
+    uint32_t pub_count;                 // Events published
+    uint32_t pub_bytes;                 // Event names and data
+    uint32_t i2c;                       // I2C transfers
+  };
+  extern Counters counters[SIM_PHASES];
+  extern Counters slept[SIM_PHASES];   // Counters of the last cycle, wake to sleep
+  extern int (*phase_fn)();             // Current phase, 0 when not set
+
+  struct Event {
+    uint64_t ms;                        // Virtual time
+    std::string name;
+    std::string data;
+  };
+  extern std::vector<Event> events;     // Published events
+
+  extern uint64_t now_us;               // Virtual time since power on
+  extern uint32_t sleeps;               // System.sleep() calls
+
+  struct Reset {};                      // Thrown by System.reset()
+
+  void advance(uint64_t us);            // Move the clock, fire Timers that come due
+  time_t wall();                        // True time now
+  Counters &counter();                  // Counters for the current phase
+  Counters total(Counters *c);          // Sum over the phases
+  void clear();                         // Zero the counters and the event list
+  bool cycle(void (*loop_fn)());        // Run loop_fn until it sleeps, false when it has not in a day
+}
@@ -0,0 +1,3 @@
+// Wire.h - Host stand-in, everything is in Particle.h
+#pragma once
+#include "Particle.h"
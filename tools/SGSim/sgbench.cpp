@@ -0,0 +1,267 @@
+/*
+ * ======================================================================================================================
+ *  sgbench.cpp - Awake time benchmark, fails when a scenario is over the stored baseline
+ *
+ *  Awake time is the battery budget. Each scenario runs the firmware in the simulator (see sgsim.cpp) from a
+ *  fresh process and SD card and measures one cycle, from wake up to the next sleep. For each PERF phase it
+ *  reports the virtual awake milliseconds, blocking delay() calls, bytes written to the SD card and bytes
+ *  published, then a total row.
+ *
+ *    cold      Cold boot with the RTC not set, the first cycle waits on the cloud for the time
+ *    normal    Second cycle after a normal boot
+ *    n2s192    Network back after 192 failed cycles, the cycle publishing the N2S backlog
+ *    failconn  Second cycle with the network never attaching
+ *    nosensor  Second cycle with only the RTC on the bus
+ *
+ *  A row fails when its awake time is more than SGB_AWAKE_PCT percent and SGB_AWAKE_MS over the baseline, it
+ *  makes more delay() calls, or it writes or publishes more than SGB_BYTES_PCT percent over the baseline.
+ *
+ *  Build
+ *    make sgbench
+ *
+ *  Usage
+ *    sgbench [-u] [-s scenario] baseline
+ *      -u              Write the results as the new baseline instead of checking them
+ *      -s scenario     Run only this scenario
+ *
+ *  Exit status is 1 if a row is over the baseline or a scenario did not complete, 0 otherwise.
+ * ======================================================================================================================
+ */
+#include "Sim.h"
+#include "../../src/SSG-ULP.ino"
+#include <ftw.h>
+#include <map>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define SGB_AWAKE_PCT   5               // Awake time allowed over the baseline, percent
+#define SGB_AWAKE_MS    100             // and milliseconds, both must be exceeded to fail
+#define SGB_BYTES_PCT   10              // SD and published bytes allowed over the baseline, percent
+#define SGB_N2S         192             // Backlog for the n2s192 scenario, one record per failed cycle
+#define SGB_ROWS        (PERF_PHASES + 1)
+
+typedef struct {
+  uint32_t awake_ms;
+  uint32_t delays;
+  uint32_t sd_bytes;
+  uint32_t pub_bytes;
+} SGB_ROW;
+
+typedef struct {
+  bool ok;
+  uint32_t n2s;                         // N2S records waiting when the measured cycle started
+  SGB_ROW rows[SGB_ROWS];               // Per PERF phase, then the total
+} SGB_RESULT;
+
+typedef struct {
+  const char *name;
+  void (*setup)();                      // Sim::cfg changes before power on
+  int warmup;                           // Cycles to run before the measured one
+  void (*before)();                     // Called before the measured cycle
+} SGB_SCENARIO;
+
+static void sgb_cold() { Sim::cfg.rtc_set = false; }
+static void sgb_none() {}
+static void sgb_netfail() { Sim::cfg.net_fail = true; }
+static void sgb_netback() { Sim::cfg.net_fail = false; }
+static void sgb_nosensor() { Sim::cfg.sensors = false; }
+
+static const SGB_SCENARIO scenarios[] = {
+  {"cold",     sgb_cold,     0,       sgb_none},
+  {"normal",   sgb_none,     1,       sgb_none},
+  {"n2s192",   sgb_netfail,  SGB_N2S, sgb_netback},
+  {"failconn", sgb_netfail,  1,       sgb_none},
+  {"nosensor", sgb_nosensor, 1,       sgb_none},
+};
+
+static int sgb_phase() {
+  return perf_phase;
+}
+
+static int sgb_unlink(const char *path, const struct stat *, int, struct FTW *) {
+  return remove(path);
+}
+
+static void sgb_rmdir(const char *path) {
+  nftw(path, sgb_unlink, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+/*
+ * ======================================================================================================================
+ *  sgb_run() - Run a scenario in this process, fill in the result
+ * ======================================================================================================================
+ */
+static void sgb_run(const SGB_SCENARIO *sc, SGB_RESULT *r) {
+  Sim::cfg.sd_dir = std::string("sgbench.sd/") + sc->name;
+  sgb_rmdir(Sim::cfg.sd_dir.c_str());
+  mkdir("sgbench.sd", 0755);
+  Sim::phase_fn = sgb_phase;
+  SerialConsoleEnabled = false;
+  sc->setup();
+
+  try {
+    setup();
+    for (int i=0; i<sc->warmup; i++) {
+      if (!Sim::cycle(loop)) {
+        return;
+      }
+    }
+    sc->before();
+    r->n2s = (eeprom_valid) ? eeprom.n2s_count : 0;
+    if (!Sim::cycle(loop)) {
+      return;
+    }
+  }
+  catch (Sim::Reset &) {
+    return;
+  }
+
+  SGB_ROW *t = &r->rows[PERF_PHASES];
+  for (int i=0; i<PERF_PHASES; i++) {
+    SGB_ROW *row = &r->rows[i];
+    row->awake_ms = perf_last.phase_ms[i];
+    row->delays = Sim::slept[i].delays;
+    row->sd_bytes = Sim::slept[i].sd_bytes;
+    row->pub_bytes = Sim::slept[i].pub_bytes;
+    t->delays += row->delays;
+    t->sd_bytes += row->sd_bytes;
+    t->pub_bytes += row->pub_bytes;
+  }
+  t->awake_ms = perf_awake_last;
+  r->ok = true;
+}
+
+/*
+ * ======================================================================================================================
+ *  sgb_baseline() - Read the baseline, rows of scenario phase awake_ms delays sd_bytes pub_bytes
+ * ======================================================================================================================
+ */
+static bool sgb_baseline(const char *path, std::map<std::string, SGB_ROW> &base) {
+  FILE *fp = fopen(path, "r");
+  char line[256], sc[32], ph[32];
+  SGB_ROW row;
+
+  if (!fp) {
+    return false;
+  }
+  while (fgets(line, sizeof(line), fp)) {
+    if ((line[0] == '#') || (sscanf(line, "%31s %31s %u %u %u %u", sc, ph, &row.awake_ms, &row.delays,
+         &row.sd_bytes, &row.pub_bytes) != 6)) {
+      continue;
+    }
+    base[std::string(sc) + " " + ph] = row;
+  }
+  fclose(fp);
+  return true;
+}
+
+static bool sgb_over(uint32_t v, uint32_t base, uint32_t pct, uint32_t slack) {
+  return (v > base + (uint64_t) base * pct / 100) && (v > base + slack);
+}
+
+int main(int argc, char **argv) {
+  const char *only = NULL;
+  bool update = false;
+  std::map<std::string, SGB_ROW> base;
+  int status = 0;
+  int c;
+
+  while ((c = getopt(argc, argv, "us:")) != -1) {
+    switch (c) {
+      case 'u' : update = true; break;
+      case 's' : only = optarg; break;
+      default  : optind = argc; break;
+    }
+  }
+  if (optind != argc - 1) {
+    fprintf(stderr, "usage: %s [-u] [-s scenario] baseline\n", argv[0]);
+    return 1;
+  }
+  if (!update && !sgb_baseline(argv[optind], base)) {
+    fprintf(stderr, "sgbench: %s: cannot read baseline\n", argv[optind]);
+    return 1;
+  }
+
+  // Each scenario gets a fresh process, the firmware's globals and retained memory start from power on
+  SGB_RESULT *r = (SGB_RESULT *) mmap(NULL, sizeof(SGB_RESULT), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+    -1, 0);
+  FILE *out = (update) ? fopen(argv[optind], "w") : stdout;
+  if ((r == MAP_FAILED) || !out) {
+    perror("sgbench");
+    return 1;
+  }
+  fprintf(out, "# %-10s %-6s %9s %7s %9s %9s\n", "scenario", "phase", "awake_ms", "delays", "sd_bytes", "pub_bytes");
+
+  for (const SGB_SCENARIO &sc : scenarios) {
+    if (only && strcmp(only, sc.name)) {
+      continue;
+    }
+    memset(r, 0, sizeof(SGB_RESULT));
+    fflush(out);
+    pid_t pid = fork();
+    if (pid == 0) {
+      sgb_run(&sc, r);
+      _exit(0);
+    }
+    waitpid(pid, NULL, 0);
+
+    if (!r->ok) {
+      fprintf(stderr, "sgbench: %s: did not complete a cycle\n", sc.name);
+      status = 1;
+      continue;
+    }
+    if (!strcmp(sc.name, "n2s192") && (r->n2s != SGB_N2S)) {
+      fprintf(stderr, "sgbench: %s: backlog was %lu records\n", sc.name, (unsigned long) r->n2s);
+      status = 1;
+    }
+
+    for (int i=0; i<SGB_ROWS; i++) {
+      SGB_ROW *row = &r->rows[i];
+      const char *phase = (i < PERF_PHASES) ? perf_phase_key[i] : "total";
+      if (!row->awake_ms && !row->delays && !row->sd_bytes && !row->pub_bytes) {
+        continue;
+      }
+      fprintf(out, "  %-10s %-6s %9lu %7lu %9lu %9lu", sc.name, phase, (unsigned long) row->awake_ms,
+        (unsigned long) row->delays, (unsigned long) row->sd_bytes, (unsigned long) row->pub_bytes);
+      if (update) {
+        fprintf(out, "\n");
+        continue;
+      }
+
+      // A phase missing from the baseline had nothing in it
+      SGB_ROW b = {};
+      auto it = base.find(std::string(sc.name) + " " + phase);
+      if (it != base.end()) {
+        b = it->second;
+      }
+      std::string why;
+      if (sgb_over(row->awake_ms, b.awake_ms, SGB_AWAKE_PCT, SGB_AWAKE_MS)) {
+        why += " awake_ms>" + std::to_string(b.awake_ms);
+      }
+      if (row->delays > b.delays) {
+        why += " delays>" + std::to_string(b.delays);
+      }
+      if (sgb_over(row->sd_bytes, b.sd_bytes, SGB_BYTES_PCT, 0)) {
+        why += " sd_bytes>" + std::to_string(b.sd_bytes);
+      }
+      if (sgb_over(row->pub_bytes, b.pub_bytes, SGB_BYTES_PCT, 0)) {
+        why += " pub_bytes>" + std::to_string(b.pub_bytes);
+      }
+      if (why.empty()) {
+        fprintf(out, "\n");
+      }
+      else {
+        fprintf(out, "  FAIL%s\n", why.c_str());
+        status = 1;
+      }
+    }
+  }
+
+  if (update) {
+    fclose(out);
+  }
+  sgb_rmdir("sgbench.sd");
+  return status;
+}
@@ -0,0 +1,334 @@
+/*
+ * ======================================================================================================================
+ *  sgbmp3.cpp - Check the BMP3 library's single precision compensation against double, benchmark the two
+ *
+ *  Adafruit_BMP3XX compensates in float (BMP3_FLOAT_COMPENSATION in bmp3_defs.h), the Cortex-M4F only has a
+ *  single precision FPU and does double math in software. bmp3.c is built once each way (see sgbmp3_comp.c) and
+ *  the float results are held to the double ones:
+ *
+ *    sgbmp3.vectors  Calibration bytes and raw readings with the double results. These are generated by sgbmp3 -g
+ *                    from calibrations spread around a typical BMP388 and readings placed on a grid over the
+ *                    sensor's range, they are not captured from a sensor. The double build must reproduce them.
+ *    Random sweep    SGB3_SWEEP further calibrations, readings placed at random over -40 to 85 C and 300 to
+ *                    1100 hPa.
+ *
+ *  Float passes when it is within SGB3_MAX_DT C and SGB3_MAX_DP Pa of double. Pressure is observed in hPa with
+ *  2 decimals, temperature with 1, so these are well under what is reported. Then both builds are timed, in TSC
+ *  cycles on x86 and nanoseconds. The host has a double FPU, the gap on the device is larger.
+ *
+ *  Build
+ *    make sgbmp3
+ *
+ *  Usage
+ *    sgbmp3 [-g] [vectors]
+ *      -g              Write new vectors to stdout instead of checking them
+ *      vectors         Vectors file (default sgbmp3.vectors)
+ *
+ *  Exit status is 1 if a result is out of bounds or the vectors cannot be read or reproduced, 0 otherwise.
+ * ======================================================================================================================
+ */
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define SGB3_CALIB      21              // BMP3_LEN_CALIB_DATA
+#define SGB3_MAX_DT     0.0005          // Float allowed off double, C
+#define SGB3_MAX_DP     0.1             // Float allowed off double, Pa
+#define SGB3_REPRO      1e-9            // Double allowed off the stored vectors, relative
+#define SGB3_SWEEP      2000            // Random calibrations
+#define SGB3_POINTS     64              // Random readings per calibration
+#define SGB3_BENCH      4096            // Readings per timed call
+
+extern "C" {
+void sgbmp3_float(const uint8_t *calib, int n, const uint32_t *up, const uint32_t *ut, double *t, double *p);
+void sgbmp3_double(const uint8_t *calib, int n, const uint32_t *up, const uint32_t *ut, double *t, double *p);
+}
+
+// A typical BMP388, par_t1 to par_p11 as the registers hold them, and their sizes in bytes
+static const int sgb3_typical[11 + 3] = {27504, 19114, -7, 410, -2113, 35, 1, 25183, 30523, 3, -6, 16071, 18, -60};
+static const int sgb3_bytes[11 + 3] = {2, 2, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 1, 1};
+
+static uint32_t sgb3_rand_state = 1;
+
+static uint32_t sgb3_rand() {
+  sgb3_rand_state = sgb3_rand_state * 1103515245 + 12345;
+  return sgb3_rand_state >> 8;
+}
+
+static double sgb3_uniform(double lo, double hi) {
+  return lo + (hi - lo) * (sgb3_rand() & 0xFFFF) / 65535.0;
+}
+
+/*
+ * ======================================================================================================================
+ *  sgb3_calib() - Calibration bytes with each parameter up to pct percent off the typical sensor
+ * ======================================================================================================================
+ */
+static void sgb3_calib(uint8_t *calib, double pct) {
+  uint8_t *c = calib;
+
+  for (int i=0; i<14; i++) {
+    double v = sgb3_typical[i] * (1.0 + sgb3_uniform(-pct, pct) / 100.0);
+    long r = lround(v);
+    if (sgb3_bytes[i] == 1) {
+      r = (r < -128) ? -128 : (r > 127) ? 127 : r;
+      *c++ = (uint8_t) r;
+    }
+    else {
+      *c++ = (uint8_t) (r & 0xFF);
+      *c++ = (uint8_t) ((r >> 8) & 0xFF);
+    }
+  }
+}
+
+/*
+ * ======================================================================================================================
+ *  sgb3_raw() - Raw readings that compensate to t C and p Pa in double, false if the calibration cannot reach them
+ * ======================================================================================================================
+ */
+static bool sgb3_raw(const uint8_t *calib, double t, double p, uint32_t *up, uint32_t *ut) {
+  uint32_t lo, hi, mid, zero = 0, full = 0xFFFFFF;
+  double ct, cp, t0, t1, p0, p1;
+
+  // Temperature does not depend on the raw pressure, search it first. Either may fall as the raw reading rises.
+  sgbmp3_double(calib, 1, &zero, &zero, &t0, &cp);
+  sgbmp3_double(calib, 1, &zero, &full, &t1, &cp);
+  for (lo = 0, hi = full; lo < hi; ) {
+    mid = lo + (hi - lo) / 2;
+    sgbmp3_double(calib, 1, &zero, &mid, &ct, &cp);
+    if ((t1 > t0) ? (ct < t) : (ct > t)) lo = mid + 1; else hi = mid;
+  }
+  *ut = lo;
+
+  sgbmp3_double(calib, 1, &zero, ut, &ct, &p0);
+  sgbmp3_double(calib, 1, &full, ut, &ct, &p1);
+  for (lo = 0, hi = full; lo < hi; ) {
+    mid = lo + (hi - lo) / 2;
+    sgbmp3_double(calib, 1, &mid, ut, &ct, &cp);
+    if ((p1 > p0) ? (cp < p) : (cp > p)) lo = mid + 1; else hi = mid;
+  }
+  *up = lo;
+
+  sgbmp3_double(calib, 1, up, ut, &ct, &cp);
+  return (fabs(ct - t) < 0.01) && (fabs(cp - p) < 1.0);
+}
+
+static void sgb3_hex(const uint8_t *calib, char *hex) {
+  for (int i=0; i<SGB3_CALIB; i++) {
+    sprintf(hex + i * 2, "%02x", calib[i]);
+  }
+}
+
+static bool sgb3_unhex(const char *hex, uint8_t *calib) {
+  unsigned int b;
+
+  if (strlen(hex) != SGB3_CALIB * 2) {
+    return false;
+  }
+  for (int i=0; i<SGB3_CALIB; i++) {
+    if (sscanf(hex + i * 2, "%2x", &b) != 1) {
+      return false;
+    }
+    calib[i] = (uint8_t) b;
+  }
+  return true;
+}
+
+/*
+ * ======================================================================================================================
+ *  sgb3_generate() - Write vectors, 8 calibrations on a 6 x 5 grid of temperature and pressure
+ * ======================================================================================================================
+ */
+static void sgb3_generate() {
+  const double temps[] = {-40, -15, 10, 35, 60, 85};
+  const double press[] = {30000, 50000, 70000, 90000, 110000};
+  uint8_t calib[SGB3_CALIB];
+  char hex[SGB3_CALIB * 2 + 1];
+  uint32_t up, ut;
+  double t, p;
+
+  printf("# Generated by sgbmp3 -g from calibrations around a typical BMP388, not captured from a sensor\n");
+  printf("# calibration up ut temperature_C pressure_Pa, the last two from the double precision build\n");
+  for (int c=0; c<8; c++) {
+    sgb3_calib(calib, (c) ? 10 : 0);
+    sgb3_hex(calib, hex);
+    for (double tt : temps) {
+      for (double pp : press) {
+        if (sgb3_raw(calib, tt, pp, &up, &ut)) {
+          sgbmp3_double(calib, 1, &up, &ut, &t, &p);
+          printf("%s %lu %lu %.9f %.6f\n", hex, (unsigned long) up, (unsigned long) ut, t, p);
+        }
+      }
+    }
+  }
+}
+
+typedef struct {
+  int n;
+  double dt;
+  double dp;
+} SGB3_ERR;
+
+static void sgb3_check(const uint8_t *calib, int n, const uint32_t *up, const uint32_t *ut, SGB3_ERR *err) {
+  static double td[SGB3_BENCH], pd[SGB3_BENCH], tf[SGB3_BENCH], pf[SGB3_BENCH];
+
+  sgbmp3_double(calib, n, up, ut, td, pd);
+  sgbmp3_float(calib, n, up, ut, tf, pf);
+  for (int i=0; i<n; i++) {
+    err->dt = fmax(err->dt, fabs(tf[i] - td[i]));
+    err->dp = fmax(err->dp, fabs(pf[i] - pd[i]));
+  }
+  err->n += n;
+}
+
+static int sgb3_verdict(const char *what, const SGB3_ERR *err) {
+  bool ok = (err->n > 0) && (err->dt <= SGB3_MAX_DT) && (err->dp <= SGB3_MAX_DP);
+
+  printf("%-8s %6d readings, float off double by at most %.2e C %.2e Pa%s\n", what, err->n, err->dt, err->dp,
+    (ok) ? "" : "  FAIL");
+  return (ok) ? 0 : 1;
+}
+
+/*
+ * ======================================================================================================================
+ *  sgb3_vectors() - Check the stored vectors, the double build must reproduce them and float stay in bounds
+ * ======================================================================================================================
+ */
+static int sgb3_vectors(const char *path) {
+  FILE *fp = fopen(path, "r");
+  char line[256], hex[64];
+  uint8_t calib[SGB3_CALIB];
+  unsigned long up, ut;
+  uint32_t u32p, u32t;
+  double t, p, ct, cp;
+  SGB3_ERR err = {};
+  int failed = 0;
+
+  if (!fp) {
+    fprintf(stderr, "sgbmp3: %s: cannot read vectors\n", path);
+    return 1;
+  }
+  while (fgets(line, sizeof(line), fp)) {
+    if ((line[0] == '#') || (sscanf(line, "%63s %lu %lu %lf %lf", hex, &up, &ut, &t, &p) != 5) ||
+        !sgb3_unhex(hex, calib)) {
+      continue;
+    }
+    u32p = (uint32_t) up;
+    u32t = (uint32_t) ut;
+    sgbmp3_double(calib, 1, &u32p, &u32t, &ct, &cp);
+    if ((fabs(ct - t) > SGB3_REPRO * fmax(fabs(t), 1.0)) || (fabs(cp - p) > SGB3_REPRO * p)) {
+      printf("FAIL %s %lu %lu: double gives %.9f C %.6f Pa, vectors have %.9f C %.6f Pa\n", hex, up, ut, ct, cp,
+        t, p);
+      failed++;
+    }
+    sgb3_check(calib, 1, &u32p, &u32t, &err);
+  }
+  fclose(fp);
+  return failed + sgb3_verdict("vectors", &err);
+}
+
+/*
+ * ======================================================================================================================
+ *  sgb3_sweep() - Random calibrations up to 20 percent off typical, random readings over the range
+ * ======================================================================================================================
+ */
+static int sgb3_sweep() {
+  static uint32_t up[SGB3_POINTS], ut[SGB3_POINTS];
+  uint8_t calib[SGB3_CALIB];
+  SGB3_ERR err = {};
+
+  for (int c=0; c<SGB3_SWEEP; c++) {
+    sgb3_calib(calib, 20);
+    int n = 0;
+    for (int i=0; i<SGB3_POINTS; i++) {
+      if (sgb3_raw(calib, sgb3_uniform(-40, 85), sgb3_uniform(30000, 110000), &up[n], &ut[n])) {
+        n++;
+      }
+    }
+    sgb3_check(calib, n, up, ut, &err);
+  }
+  return sgb3_verdict("sweep", &err);
+}
+
+static uint64_t sgb3_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+static double sgb3_now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * ======================================================================================================================
+ *  sgb3_bench() - Time one compensation of temperature and pressure in each build
+ * ======================================================================================================================
+ */
+static void sgb3_bench() {
+  static uint32_t up[SGB3_BENCH], ut[SGB3_BENCH];
+  static double t[SGB3_BENCH], p[SGB3_BENCH];
+  void (*fn[2])(const uint8_t *, int, const uint32_t *, const uint32_t *, double *, double *) =
+    {sgbmp3_double, sgbmp3_float};
+  const char *name[2] = {"double", "float"};
+  uint8_t calib[SGB3_CALIB];
+  const int reps = 200;
+
+  sgb3_calib(calib, 0);
+  for (int i=0; i<SGB3_BENCH; i++) {
+    if (!sgb3_raw(calib, sgb3_uniform(-40, 85), sgb3_uniform(30000, 110000), &up[i], &ut[i])) {
+      up[i] = up[0];
+      ut[i] = ut[0];
+    }
+  }
+
+  printf("\n%-8s %12s %12s\n", "build", "cycles", "ns");
+  for (int b=0; b<2; b++) {
+    fn[b](calib, SGB3_BENCH, up, ut, t, p);
+    uint64_t c0 = sgb3_ticks();
+    double t0 = sgb3_now_ns();
+    for (int r=0; r<reps; r++) {
+      fn[b](calib, SGB3_BENCH, up, ut, t, p);
+    }
+    double t1 = sgb3_now_ns();
+    uint64_t c1 = sgb3_ticks();
+    printf("%-8s %12.1f %12.2f\n", name[b], (double) (c1 - c0) / reps / SGB3_BENCH, (t1 - t0) / reps / SGB3_BENCH);
+  }
+}
+
+int main(int argc, char **argv) {
+  const char *path = "sgbmp3.vectors";
+  bool generate = false;
+  int c;
+
+  while ((c = getopt(argc, argv, "g")) != -1) {
+    switch (c) {
+      case 'g' : generate = true; break;
+      default  :
+        fprintf(stderr, "usage: %s [-g] [vectors]\n", argv[0]);
+        return 1;
+    }
+  }
+  if (optind < argc) {
+    path = argv[optind];
+  }
+  if (generate) {
+    sgb3_generate();
+    return 0;
+  }
+
+  int failed = sgb3_vectors(path);
+  failed += sgb3_sweep();
+  sgb3_bench();
+  return (failed) ? 1 : 0;
+}
@@ -0,0 +1,32 @@
+/*
+ * ======================================================================================================================
+ *  sgbmp3_comp.c - The BMP3 library's compensation, built once as float and once as double for sgbmp3.cpp
+ *
+ *  parse_calib_data() and compensate_data() are static in bmp3.c, so it is included here. The Makefile builds
+ *  this file with BMP3_FLOAT_COMPENSATION 1 and 0 and SGBMP3_FN naming the entry point, then keeps only that
+ *  symbol global so the two copies of bmp3.c link into one program.
+ * ======================================================================================================================
+ */
+#include <string.h>
+#include "bmp3.c"
+
+/*
+ * ======================================================================================================================
+ *  SGBMP3_FN() - Compensate n raw readings with the 21 calibration bytes, as bmp3_get_sensor_data() does for one
+ * ======================================================================================================================
+ */
+void SGBMP3_FN(const uint8_t *calib, int n, const uint32_t *up, const uint32_t *ut, double *t, double *p) {
+  struct bmp3_dev dev;
+  struct bmp3_uncomp_data uncomp;
+  struct bmp3_data data;
+
+  memset(&dev, 0, sizeof(dev));
+  parse_calib_data(calib, &dev);
+  for (int i=0; i<n; i++) {
+    uncomp.pressure = up[i];
+    uncomp.temperature = ut[i];
+    compensate_data(BMP3_PRESS | BMP3_TEMP, &uncomp, &data, &dev.calib_data);
+    t[i] = data.temperature;
+    p[i] = data.pressure;
+  }
+}
@@ -0,0 +1,299 @@
+/*
+ * ======================================================================================================================
+ *  sgfmt.cpp - Check the fixed point formatting against snprintf(), benchmark the two
+ *
+ *  The FMT functions in src/SF.h are compiled as is, with the rest of the firmware. Each is held to what
+ *  snprintf() writes for the same value:
+ *
+ *    fmt_uint     "%lu", 0 to UINT32_MAX in steps, every power of 10 and its neighbours
+ *    fmt_int      "%ld", INT32_MIN to INT32_MAX the same way
+ *    fmt_fixed    An int32 scaled by 10^precision, checked against the integer and fraction parts
+ *    fmt_float    "%.*f" at precision 0 to FMT_PRECISION_MAX, for floats in steps over the whole range that
+ *                 fmt_scale() can hold, random floats, and the floats either side of every halfway case
+ *                 up to SGF_HALF. snprintf() rounds a tie to even, fmt_scale() away from zero, so at an exact
+ *                 tie the expected text is rounded away from zero instead.
+ *
+ *  Floats past the int32 range must clamp to it, NAN and infinity must come out as "nan", "inf" and "-inf",
+ *  and fmt_json_float() must write null for them. Then fmt_uint() and fmt_float() are timed against snprintf().
+ *
+ *  Build
+ *    make sgfmt
+ *
+ *  Exit status is 1 if a result differs, 0 otherwise.
+ * ======================================================================================================================
+ */
+#include "Sim.h"
+#include "../../src/SSG-ULP.ino"
+#include <float.h>
+
+#define SGF_HALF        100000          // Halfway cases checked up to this many units of the last place
+#define SGF_RANDOM      1000000         // Random floats per precision
+#define SGF_SHOW        10              // Failures printed per check
+
+static uint32_t sgf_rand_state = 1;
+
+static uint32_t sgf_rand() {
+  sgf_rand_state = sgf_rand_state * 1103515245 + 12345;
+  return ((sgf_rand_state >> 16) << 16) | ((sgf_rand_state * 1103515245 + 12345) >> 16);
+}
+
+typedef struct {
+  const char *name;
+  long cases;
+  long failed;
+} SGF_CHECK;
+
+static void sgf_compare(SGF_CHECK *c, const char *got, const char *want, const char *what) {
+  c->cases++;
+  if (strcmp(got, want)) {
+    if (c->failed++ < SGF_SHOW) {
+      printf("FAIL %s %s: \"%s\" want \"%s\"\n", c->name, what, got, want);
+    }
+  }
+}
+
+static int sgf_verdict(const SGF_CHECK *c) {
+  printf("%-10s %10ld cases, %ld failed\n", c->name, c->cases, c->failed);
+  return (c->failed) ? 1 : 0;
+}
+
+/*
+ * ======================================================================================================================
+ *  sgf_uint() - fmt_uint() against "%lu"
+ * ======================================================================================================================
+ */
+static void sgf_uint(SGF_CHECK *c, uint32_t v) {
+  char got[16], want[16], what[16];
+  FMT_BUF f;
+
+  fmt_begin(&f, got, sizeof(got));
+  fmt_uint(&f, v);
+  snprintf(want, sizeof(want), "%lu", (unsigned long) v);
+  snprintf(what, sizeof(what), "%lu", (unsigned long) v);
+  sgf_compare(c, got, want, what);
+}
+
+/*
+ * ======================================================================================================================
+ *  sgf_int() - fmt_int() against "%ld"
+ * ======================================================================================================================
+ */
+static void sgf_int(SGF_CHECK *c, int32_t v) {
+  char got[16], want[16], what[16];
+  FMT_BUF f;
+
+  fmt_begin(&f, got, sizeof(got));
+  fmt_int(&f, v);
+  snprintf(want, sizeof(want), "%ld", (long) v);
+  snprintf(what, sizeof(what), "%ld", (long) v);
+  sgf_compare(c, got, want, what);
+}
+
+/*
+ * ======================================================================================================================
+ *  sgf_fixed() - fmt_fixed() against the integer and fraction parts written by snprintf()
+ * ======================================================================================================================
+ */
+static void sgf_fixed(SGF_CHECK *c, int32_t v, int precision) {
+  char got[24], want[24], what[24];
+  long long a = llabs((long long) v);
+  long long p = fmt_pow10[precision];
+  FMT_BUF f;
+
+  fmt_begin(&f, got, sizeof(got));
+  fmt_fixed(&f, v, precision);
+  if (precision) {
+    snprintf(want, sizeof(want), "%s%lld.%0*lld", (v < 0) ? "-" : "", a / p, precision, a % p);
+  }
+  else {
+    snprintf(want, sizeof(want), "%ld", (long) v);
+  }
+  snprintf(what, sizeof(what), "%ld/%d", (long) v, precision);
+  sgf_compare(c, got, want, what);
+}
+
+/*
+ * ======================================================================================================================
+ *  sgf_float() - fmt_float() against "%.*f", ties rounded away from zero, values past the int32 range clamped
+ * ======================================================================================================================
+ */
+static void sgf_float(SGF_CHECK *c, float v, int precision) {
+  char got[48], want[48], what[48];
+  double p = fmt_pow10[precision];
+  double x = (double) v * p;            // Exact, a 24 bit mantissa times 10^4 fits in 53 bits
+  FMT_BUF f;
+
+  fmt_begin(&f, got, sizeof(got));
+  fmt_float(&f, v, precision);
+  if (isnan(v)) {
+    strcpy(want, "nan");
+  }
+  else if (isinf(v)) {
+    strcpy(want, (v > 0) ? "inf" : "-inf");
+  }
+  else if (fabs(x) >= 2147483520.0) {
+    FMT_BUF w;
+    fmt_begin(&w, want, sizeof(want));
+    fmt_fixed(&w, (v > 0) ? INT32_MAX : -INT32_MAX, precision);
+  }
+  else if (x - floor(x) == 0.5) {
+    snprintf(want, sizeof(want), "%.*f", precision, (x > 0 ? floor(x) + 1 : floor(x)) / p);
+  }
+  else {
+    snprintf(want, sizeof(want), "%.*f", precision, (double) v);
+  }
+  // snprintf() writes -0 for a negative value that rounds to 0, the sign is dropped with it
+  if (isfinite(v) && (want[0] == '-') && !strpbrk(want, "123456789")) {
+    memmove(want, want + 1, strlen(want));
+  }
+  snprintf(what, sizeof(what), "%.9g/%d", v, precision);
+  sgf_compare(c, got, want, what);
+}
+
+/*
+ * ======================================================================================================================
+ *  sgf_json() - fmt_json_float() writes null for what JSON cannot hold
+ * ======================================================================================================================
+ */
+static void sgf_json(SGF_CHECK *c, float v, const char *want) {
+  char got[32], what[16];
+  FMT_BUF f;
+
+  fmt_begin(&f, got, sizeof(got));
+  fmt_char(&f, '{');
+  fmt_json_float(&f, "v", v, 2);
+  fmt_char(&f, '}');
+  snprintf(what, sizeof(what), "%g", v);
+  sgf_compare(c, got, want, what);
+}
+
+static double sgf_now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main() {
+  SGF_CHECK cu = {"fmt_uint"}, ci = {"fmt_int"}, cx = {"fmt_fixed"}, cf = {"fmt_float"}, cj = {"json"};
+  int failed = 0;
+
+  for (uint64_t v=0; v<=UINT32_MAX; v+=9973) {
+    sgf_uint(&cu, (uint32_t) v);
+    sgf_int(&ci, (int32_t) (uint32_t) v);
+  }
+  for (uint64_t p=1; p<=UINT32_MAX; p*=10) {
+    for (int d=-1; d<=1; d++) {
+      sgf_uint(&cu, (uint32_t) (p + d));
+      sgf_int(&ci, (int32_t) (p + d));
+      sgf_int(&ci, (int32_t) -(p + d));
+    }
+  }
+  sgf_uint(&cu, UINT32_MAX);
+  sgf_int(&ci, INT32_MAX);
+  sgf_int(&ci, INT32_MIN);
+
+  for (int precision=0; precision<=FMT_PRECISION_MAX; precision++) {
+    for (int64_t v=INT32_MIN; v<=INT32_MAX; v+=9973) {
+      sgf_fixed(&cx, (int32_t) v, precision);
+    }
+    for (int32_t v=-100000; v<=100000; v++) {
+      sgf_fixed(&cx, v, precision);
+    }
+    sgf_fixed(&cx, INT32_MAX, precision);
+    sgf_fixed(&cx, INT32_MIN, precision);
+
+    // Every float bit pattern in steps, both signs, through the clamp at the int32 range up to infinity and NAN
+    for (uint64_t b=0; b<=UINT32_MAX; b+=4099) {
+      float v;
+      uint32_t u = (uint32_t) b;
+      memcpy(&v, &u, sizeof(v));
+      sgf_float(&cf, v, precision);
+    }
+    for (int i=0; i<SGF_RANDOM; i++) {
+      uint32_t u = sgf_rand();
+      float v;
+      memcpy(&v, &u, sizeof(v));
+      if (fabsf(v) < 1e6f) {
+        sgf_float(&cf, v, precision);
+      }
+      else {
+        sgf_float(&cf, ldexpf((float) (int32_t) u, -24), precision);
+      }
+    }
+
+    // The floats either side of each halfway point, where a float multiply can land on the wrong side
+    for (int32_t k=0; k<SGF_HALF; k++) {
+      float h = (float) ((k + 0.5) / fmt_pow10[precision]);
+      for (float v : {nextafterf(h, 0), h, nextafterf(h, INFINITY)}) {
+        sgf_float(&cf, v, precision);
+        sgf_float(&cf, -v, precision);
+      }
+    }
+    for (float v : {0.0f, -0.0f, NAN, INFINITY, -INFINITY, 1677.7216f, 16777216.0f, 2147483520.0f, FLT_MAX}) {
+      sgf_float(&cf, v, precision);
+      sgf_float(&cf, -v, precision);
+    }
+  }
+
+  sgf_json(&cj, 1.005f, "{\"v\":1.00}");
+  sgf_json(&cj, -2.5f, "{\"v\":-2.50}");
+  sgf_json(&cj, NAN, "{\"v\":null}");
+  sgf_json(&cj, INFINITY, "{\"v\":null}");
+  sgf_json(&cj, -INFINITY, "{\"v\":null}");
+
+  failed += sgf_verdict(&cu);
+  failed += sgf_verdict(&ci);
+  failed += sgf_verdict(&cx);
+  failed += sgf_verdict(&cf);
+  failed += sgf_verdict(&cj);
+
+  // Nanoseconds per value written
+  static float fv[4096];
+  static uint32_t uv[4096];
+  const int reps = 200;
+  char buf[48];
+  FMT_BUF f;
+  volatile size_t sink = 0;
+
+  for (int i=0; i<4096; i++) {
+    uv[i] = sgf_rand() >> (sgf_rand() & 31);
+    fv[i] = ldexpf((float) (int32_t) sgf_rand(), -20);
+  }
+  printf("\n%-10s %12s %12s\n", "", "fmt", "snprintf");
+  for (int precision=-1; precision<=FMT_PRECISION_MAX; precision++) {
+    double t0 = sgf_now_ns();
+    for (int r=0; r<reps; r++) {
+      for (int i=0; i<4096; i++) {
+        fmt_begin(&f, buf, sizeof(buf));
+        if (precision < 0) {
+          fmt_uint(&f, uv[i]);
+        }
+        else {
+          fmt_float(&f, fv[i], precision);
+        }
+        sink = sink + f.len;
+      }
+    }
+    double t1 = sgf_now_ns();
+    for (int r=0; r<reps; r++) {
+      for (int i=0; i<4096; i++) {
+        if (precision < 0) {
+          sink = sink + snprintf(buf, sizeof(buf), "%lu", (unsigned long) uv[i]);
+        }
+        else {
+          sink = sink + snprintf(buf, sizeof(buf), "%.*f", precision, fv[i]);
+        }
+      }
+    }
+    double t2 = sgf_now_ns();
+    char name[16];
+    if (precision < 0) {
+      strcpy(name, "uint");
+    }
+    else {
+      snprintf(name, sizeof(name), "float %d", precision);
+    }
+    printf("%-10s %12.1f %12.1f\n", name, (t1 - t0) / reps / 4096, (t2 - t1) / reps / 4096);
+  }
+  return (failed) ? 1 : 0;
+}
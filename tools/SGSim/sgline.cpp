@@ -0,0 +1,226 @@
+/*
+ * ======================================================================================================================
+ *  sgline.cpp - Check that tools/SGDecode turns SGB and SGC events back into the SG JSON the firmware writes
+ *
+ *  OBS.h and tools/SGDecode are compiled as is. The SGDecode schema for N2S_SCHEMA must list sensors[] in order,
+ *  with the same value counts, keys and precision. Then random observation records, every combination of the
+ *  OBS_F_* flags and online bits, values either side of a rounding halfway point, at the int32 clamp and with the
+ *  RTC set back between two records, are
+ *
+ *    rendered with OBS_JSON(), the SG event published live
+ *    packed with OBS_N2SEncode() and batched with OBS_N2S_Append() into SGB events, as SD_N2S_Batch() does
+ *    rendered one at a time with OBS_Compact(), the SGC event
+ *
+ *  and each SGDecode() result must equal the OBS_JSON() text. Sensor values are QC'd before they reach the record,
+ *  so NAN is not checked, OBS_Line() writes it as 0 where OBS_JSON() writes null.
+ *
+ *  Build
+ *    make sgline
+ *
+ *  Exit status is 1 if a result differs, 0 otherwise.
+ * ======================================================================================================================
+ */
+#include "Sim.h"
+#include "../../src/SSG-ULP.ino"
+#include "../SGDecode/SGDecode.h"
+
+#define SGL_RECORDS     20000           // Random records
+#define SGL_SHOW        10              // Failures printed
+
+static uint32_t sgl_rand_state = 1;
+
+static uint32_t sgl_rand() {
+  sgl_rand_state = sgl_rand_state * 1103515245 + 12345;
+  return ((sgl_rand_state >> 16) << 16) | ((sgl_rand_state * 1103515245 + 12345) >> 16);
+}
+
+static long sgl_cases = 0;
+static long sgl_failed = 0;
+
+static void sgl_fail(const char *what, const std::string &got, const std::string &want) {
+  if (sgl_failed++ < SGL_SHOW) {
+    printf("FAIL %s\n  got  %s\n  want %s\n", what, got.c_str(), want.c_str());
+  }
+}
+
+/*
+ * ======================================================================================================================
+ *  sgl_value() - A random value for precision decimal places, often one either side of a halfway point
+ * ======================================================================================================================
+ */
+static float sgl_value(int precision) {
+  float v;
+
+  switch (sgl_rand() % 8) {
+    case 0:
+      v = (float) ((int32_t) (sgl_rand() % 20001) - 10000) / 100.0f;
+      break;
+    case 1: {
+      float h = (float) (((int32_t) (sgl_rand() % 200001) - 100000 + 0.5) / fmt_pow10[precision]);
+      v = nextafterf(h, (sgl_rand() & 1) ? INFINITY : -INFINITY);
+      break;
+    }
+    case 2:
+      v = (sgl_rand() & 1) ? 3e9f : -3e9f;   // Past the int32 range once scaled, clamped
+      break;
+    case 3:
+      v = 0.0f;
+      break;
+    default:
+      v = ldexpf((float) (int32_t) sgl_rand(), -(int) (sgl_rand() % 24) - 8);
+      break;
+  }
+  return (v);
+}
+
+/*
+ * ======================================================================================================================
+ *  sgl_record() - A random observation record, ts_prev is the record before, 0 for none
+ * ======================================================================================================================
+ */
+static void sgl_record(OBS_RECORD *obs, uint32_t ts_prev) {
+  memset(obs, 0, sizeof(*obs));
+  obs->version = OBS_VERSION;
+  obs->flags = sgl_rand() & (OBS_F_SGN | OBS_F_SGRR | OBS_F_STATS);
+  if (ts_prev == 0) {
+    obs->ts = 1577836800 + sgl_rand() % 600000000;
+  }
+  else if ((sgl_rand() % 16) == 0) {
+    obs->ts = ts_prev - sgl_rand() % 86400;   // RTC set back
+  }
+  else {
+    obs->ts = ts_prev + sgl_rand() % 3600;
+  }
+  obs->sg = sgl_rand();
+  obs->sgn = sgl_rand() % 4096;
+  obs->sgrr = sgl_value(1);
+  obs->sgmn = sgl_rand();
+  obs->sgmx = sgl_rand();
+  obs->sg10 = sgl_rand();
+  obs->sg90 = sgl_rand();
+  obs->sgmad = sgl_rand();
+  obs->sgro = sgl_rand();
+  obs->online = sgl_rand() & ((1 << SENSOR_COUNT) - 1);
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    if (obs->online & (1 << i)) {
+      for (int j=0; j<sensors[i].nv; j++) {
+        obs->sv[i][j] = sgl_value(sensors[i].precision[j]);
+      }
+    }
+  }
+  obs->bcs = (int8_t) (sgl_rand() % 9) - 1;
+  obs->bpc = sgl_value(4);
+  obs->cfr = sgl_rand();
+  obs->css = sgl_value(4);
+  obs->hth = sgl_rand();
+}
+
+/*
+ * ======================================================================================================================
+ *  sgl_decode() - Decode an event payload and compare it with the OBS_JSON() text of its records
+ * ======================================================================================================================
+ */
+static void sgl_decode(const char *event, const std::string &payload, const std::vector<std::string> &want) {
+  std::vector<std::string> json;
+  std::string error;
+
+  sgl_cases++;
+  if (!SGDecode(payload, json, error)) {
+    sgl_fail(event, error, payload);
+    return;
+  }
+  if (json.size() != want.size()) {
+    sgl_fail(event, std::to_string(json.size()) + " observations", std::to_string(want.size()));
+    return;
+  }
+  for (size_t i=0; i<json.size(); i++) {
+    if (json[i] != want[i]) {
+      sgl_fail(event, json[i], want[i]);
+      return;
+    }
+  }
+}
+
+/*
+ * ======================================================================================================================
+ *  sgl_schema() - The SGDecode schema for N2S_SCHEMA against sensors[]
+ * ======================================================================================================================
+ */
+static bool sgl_schema() {
+  const SGD_SCHEMA *s = SGDecode_Schema(N2S_SCHEMA);
+
+  if (!s) {
+    printf("FAIL schema %d not in SGDecode\n", N2S_SCHEMA);
+    return (false);
+  }
+  if (s->count != (int) SENSOR_COUNT) {
+    printf("FAIL schema %d has %d sensors, firmware %d\n", N2S_SCHEMA, s->count, (int) SENSOR_COUNT);
+    return (false);
+  }
+  for (unsigned int i=0; i<SENSOR_COUNT; i++) {
+    const SGD_SENSOR *d = &s->sensors[i];
+    bool same = !strcmp(d->name, sensors[i].name) && (d->nv == sensors[i].nv);
+    for (int j=0; same && (j<sensors[i].nv); j++) {
+      same = !strcmp(d->key[j], sensors[i].key[j]) && (d->precision[j] == sensors[i].precision[j]);
+    }
+    if (!same) {
+      printf("FAIL schema %d sensor %u %s differs from sensors[] %s\n", N2S_SCHEMA, i, d->name, sensors[i].name);
+      return (false);
+    }
+  }
+  return (true);
+}
+
+int main() {
+  int max = min((int) Particle.maxEventDataSize(), MAX_MSGBUF_SIZE-1);
+  std::vector<std::string> batch;
+  std::string payload;
+  uint32_t ts_prev = 0;
+  uint32_t ts_last = 0;
+  long events = 0;
+  OBS_RECORD obs;
+  uint8_t rec[N2S_REC_MAX];
+
+  if (!sgl_schema()) {
+    return (1);
+  }
+
+  memset(msgbuf, 0, sizeof(msgbuf));
+  for (int r=0; r<SGL_RECORDS; r++) {
+    sgl_record(&obs, ts_last);
+    ts_last = obs.ts;
+    OBS_JSON(&obs, false);
+    std::string json = msgbuf;
+
+    // SGC, one observation
+    OBS_Compact(&obs);
+    sgl_decode("SGC", msgbuf, {json});
+
+    // SGB, close the event when the record does not fit, as SD_N2S_Batch() does
+    int len = OBS_N2SEncode(&obs, rec);
+    strcpy(msgbuf, payload.c_str());
+    int a = OBS_N2S_Append(rec, len, max, &ts_prev);
+    if (a == 0) {
+      sgl_decode("SGB", payload, batch);
+      events++;
+      batch.clear();
+      ts_prev = 0;
+      memset(msgbuf, 0, sizeof(msgbuf));
+      a = OBS_N2S_Append(rec, len, max, &ts_prev);
+    }
+    if (a != 1) {
+      sgl_fail("SGB", "record not appended", json);
+      return (1);
+    }
+    payload = msgbuf;
+    batch.push_back(json);
+  }
+  if (batch.size()) {
+    sgl_decode("SGB", payload, batch);
+    events++;
+  }
+
+  printf("%-10s %10d records, %ld SGB events, %ld decoded, %ld failed\n", "SGDecode", SGL_RECORDS, events,
+    sgl_cases, sgl_failed);
+  return (sgl_failed) ? 1 : 0;
+}
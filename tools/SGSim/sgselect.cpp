@@ -0,0 +1,143 @@
+/*
+ * ======================================================================================================================
+ *  sgselect.cpp - Check myselect(), mypercentile() and mymad() against a full sort, benchmark them against the
+ *                 bubble sort they replaced
+ *
+ *  The selection kernels in src/SF.h are compiled as is, with the rest of the firmware. Arrays of 0 to 4096
+ *  samples, uniform over the 12 bit ADC range, a narrow band with many repeats as a still water surface gives,
+ *  already sorted, reversed and all equal, are checked for the median, the DG_PLO and DG_PHI percentiles and the
+ *  MAD. Then each kernel is timed against mysort(), the bubble sort distance_gauge_median() used before, at sample
+ *  set sizes up to DG_MAX_BUCKETS and beyond.
+ *
+ *  Build
+ *    make sgselect
+ *
+ *  Exit status is 1 if a result differs from the full sort, 0 otherwise.
+ * ======================================================================================================================
+ */
+#include "Sim.h"
+#include "../../src/SSG-ULP.ino"
+
+/*
+ * ======================================================================================================================
+ *  mysort() - The bubble sort distance_gauge_median() used before the selection kernels
+ * ======================================================================================================================
+ */
+static void mysort(unsigned int a[], unsigned int n) {
+  unsigned int i, j;
+
+  for(i = 0;i < n-1;i++) {
+    for(j = 0;j < n-i-1;j++) {
+      if(a[j] > a[j+1])
+        myswap(&a[j],&a[j+1]);
+    }
+  }
+}
+
+static uint32_t sgs_rand_state = 1;
+
+static unsigned int sgs_rand(unsigned int range) {
+  sgs_rand_state = sgs_rand_state * 1103515245 + 12345;
+  return (sgs_rand_state >> 8) % range;
+}
+
+static void sgs_fill(unsigned int *a, unsigned int n, int pattern) {
+  for (unsigned int i=0; i<n; i++) {
+    switch (pattern) {
+      case 0  : a[i] = sgs_rand(4096); break;                // Uniform over the ADC range
+      case 1  : a[i] = 3000 + sgs_rand(5); break;            // Still water, a few counts of noise
+      case 2  : a[i] = i * 7; break;                         // Sorted
+      case 3  : a[i] = (n - i) * 7; break;                   // Reversed
+      default : a[i] = 2500; break;                          // All equal
+    }
+  }
+}
+
+static double sgs_now_us() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+int main() {
+  static unsigned int a[4096], b[4096], s[4096];
+  const unsigned int sizes[] = {1, 2, 3, 4, 5, 7, 8, 15, 16, 59, 60, 61, 120, 239, 240, 1000, 4096};
+  const char *patterns[] = {"uniform", "narrow", "sorted", "reversed", "equal"};
+  int cases = 0;
+  int failed = 0;
+
+  // No samples at all returns 0 and touches nothing
+  if (myselect(a, 0, 0) || mypercentile(a, 0, DG_PHI) || mymad(a, 0)) {
+    printf("FAIL n=0 is not 0\n");
+    failed++;
+  }
+
+  for (unsigned int n : sizes) {
+    for (int p=0; p<5; p++) {
+      for (int rep=0; rep<((n < 256) ? 50 : 5); rep++) {
+        sgs_fill(s, n, p);
+        memcpy(a, s, n * sizeof(unsigned int));
+        std::sort(a, a + n);
+
+        unsigned int km = (n+1) / 2 - 1;
+        unsigned int klo = max((int) ((DG_PLO * n) + 99) / 100 - 1, 0);
+        unsigned int khi = max((int) ((DG_PHI * n) + 99) / 100 - 1, 0);
+        unsigned int median = a[km];
+        for (unsigned int i=0; i<n; i++) {
+          b[i] = (s[i] > median) ? (s[i] - median) : (median - s[i]);
+        }
+        std::sort(b, b + n);
+        unsigned int want[4] = {median, a[klo], a[khi], b[km]};
+
+        unsigned int got[4];
+        memcpy(b, s, n * sizeof(unsigned int));
+        got[0] = myselect(b, n, km);
+        got[1] = mypercentile(b, n, DG_PLO);
+        got[2] = mypercentile(b, n, DG_PHI);
+        memcpy(b, s, n * sizeof(unsigned int));
+        got[3] = mymad(b, n);
+
+        cases++;
+        if (memcmp(want, got, sizeof(want))) {
+          printf("FAIL n=%u %s: median %u/%u p%d %u/%u p%d %u/%u mad %u/%u\n", n, patterns[p], got[0], want[0],
+            DG_PLO, got[1], want[1], DG_PHI, got[2], want[2], got[3], want[3]);
+          failed++;
+        }
+      }
+    }
+  }
+  printf("select: %d cases, %d failed\n", cases, failed);
+
+  // Microseconds for the median of one sample set, the selection kernels report the percentiles and MAD as well
+  printf("\n%6s %12s %12s %12s\n", "n", "mysort", "myselect", "+pct+mad");
+  for (unsigned int n : {60u, 120u, 240u, 1000u, 4096u}) {
+    int reps = (n <= 240) ? 2000 : 20;
+    double t_sort = 0, t_select = 0, t_all = 0;
+    volatile unsigned int sink = 0;
+
+    for (int r=0; r<reps; r++) {
+      sgs_fill(s, n, r & 1);
+
+      memcpy(a, s, n * sizeof(unsigned int));
+      double t0 = sgs_now_us();
+      mysort(a, n);
+      sink = sink + a[(n+1) / 2 - 1];
+      double t1 = sgs_now_us();
+
+      memcpy(a, s, n * sizeof(unsigned int));
+      double t2 = sgs_now_us();
+      sink = sink + myselect(a, n, (n+1) / 2 - 1);
+      double t3 = sgs_now_us();
+      sink = sink + mypercentile(a, n, DG_PLO) + mypercentile(a, n, DG_PHI);
+      memcpy(b, s, n * sizeof(unsigned int));
+      sink = sink + mymad(b, n);
+      double t4 = sgs_now_us();
+
+      t_sort += t1 - t0;
+      t_select += t3 - t2;
+      t_all += t4 - t2;
+    }
+    printf("%6u %12.2f %12.2f %12.2f\n", n, t_sort / reps, t_select / reps, t_all / reps);
+  }
+  return (failed) ? 1 : 0;
+}
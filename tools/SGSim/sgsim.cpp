@@ -0,0 +1,97 @@
+/*
+ * ======================================================================================================================
+ *  sgsim.cpp - Run the firmware on the host against modeled hardware and a virtual clock
+ *
+ *  src/SSG-ULP.ino is compiled as is with the Particle.h and SdFat.h stand-ins in this directory, see Sim.h for
+ *  how time is kept. setup() runs once, then loop() for the requested number of observation cycles, each ending
+ *  in a sleep. Each cycle prints the awake milliseconds by PERF phase, delay() calls, SD card and published bytes
+ *  and the estimated mAh.
+ *
+ *  Build
+ *    make                              Boron, make PLATFORM=12 for Argon
+ *
+ *  Usage
+ *    sgsim [options]
+ *      -n cycles       Observation cycles to run (default 4)
+ *      -d dir          Host directory that is the SD card (default sgsim.sd), it is kept between runs
+ *      -v              Serial console and publishes to stdout
+ *      -C              Cold boot, RTC has lost its time
+ *      -S              No sensors on the bus, only the RTC
+ *      -F              Network never attaches
+ *      -P              Publishes are not acknowledged
+ *      -W ms           Wake from a sleep with the modem on after ms (rapid reporting)
+ *      -D counts       Distance gauge ADC counts (default 1200)
+ *      -R counts       ADC counts per minute the distance changes by, for rapid reporting
+ *
+ *  Exit status is 1 if the firmware reset itself or a cycle did not complete, 0 otherwise.
+ * ======================================================================================================================
+ */
+#include "Sim.h"
+#include "../../src/SSG-ULP.ino"
+#include <unistd.h>
+
+static int sim_phase() {
+  return perf_phase;
+}
+
+/*
+ * ======================================================================================================================
+ *  sim_report() - One line for the cycle that just went to sleep, from the firmware's own PERF stats and ours
+ * ======================================================================================================================
+ */
+static void sim_report(uint32_t cycle) {
+  Sim::Counters t = Sim::total(Sim::slept);
+
+  printf("cycle %lu awake %lums", (unsigned long) cycle, (unsigned long) perf_awake_last);
+  for (int i=0; i<PERF_PHASES; i++) {
+    if (perf_last.phase_ms[i]) {
+      printf(" %s:%lu", perf_phase_key[i], (unsigned long) perf_last.phase_ms[i]);
+    }
+  }
+  printf(" delays:%lu i2c:%lu sdb:%lu pubb:%lu mah:%.4f\n", (unsigned long) t.delays, (unsigned long) t.i2c,
+    (unsigned long) t.sd_bytes, (unsigned long) t.pub_bytes, PERF_mAh(&perf_last));
+  fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+  uint32_t cycles = 4;
+  int c;
+
+  while ((c = getopt(argc, argv, "n:d:vCSFPW:D:R:")) != -1) {
+    switch (c) {
+      case 'n' : cycles = (uint32_t) atoi(optarg); break;
+      case 'd' : Sim::cfg.sd_dir = optarg; break;
+      case 'v' : Sim::cfg.verbose = true; break;
+      case 'C' : Sim::cfg.rtc_set = false; break;
+      case 'S' : Sim::cfg.sensors = false; break;
+      case 'F' : Sim::cfg.net_fail = true; break;
+      case 'P' : Sim::cfg.publish_fail = true; break;
+      case 'W' : Sim::cfg.network_wake_ms = (uint32_t) atoi(optarg); break;
+      case 'D' : Sim::cfg.distance = atoi(optarg); break;
+      case 'R' : Sim::cfg.ramp = atof(optarg); break;
+      default  :
+        fprintf(stderr, "usage: %s [-n cycles] [-d dir] [-v] [-C] [-S] [-F] [-P] [-W ms] [-D counts] [-R counts]\n", argv[0]);
+        return 1;
+    }
+  }
+
+  setvbuf(stdout, NULL, _IOLBF, 0);
+  Sim::phase_fn = sim_phase;
+  SerialConsoleEnabled = Sim::cfg.verbose;
+
+  try {
+    setup();
+    for (uint32_t n=1; n<=cycles; n++) {
+      if (!Sim::cycle(loop)) {
+        fprintf(stderr, "sgsim: cycle %lu did not sleep in a day\n", (unsigned long) n);
+        return 1;
+      }
+      sim_report(n);
+    }
+  }
+  catch (Sim::Reset &) {
+    fprintf(stderr, "sgsim: System.reset() at %llums\n", (unsigned long long) (Sim::now_us / 1000));
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,3 @@
+// util/delay.h - Host stand-in for the AVR header Adafruit_SSD1306 includes off ARM
+#pragma once
+#include "Particle.h"